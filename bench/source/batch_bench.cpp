@@ -0,0 +1,41 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inspector/batch.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+
+namespace {
+
+constexpr int records_per_batch = 10000;
+
+void bm_to_string_per_record(benchmark::State& state) {
+  const std::vector<int> payload{1, 2, 3, 4};
+  for (auto _ : state) {
+    std::vector<std::string> out;
+    out.reserve(records_per_batch);
+    for (int i = 0; i < records_per_batch; ++i) {
+      out.push_back(insp::to_string(payload));
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * records_per_batch);
+}
+
+void bm_batch(benchmark::State& state) {
+  const std::vector<int> payload{1, 2, 3, 4};
+  for (auto _ : state) {
+    insp::batch b;
+    for (int i = 0; i < records_per_batch; ++i) {
+      b.add(payload);
+    }
+    benchmark::DoNotOptimize(b.text().data());
+  }
+  state.SetItemsProcessed(state.iterations() * records_per_batch);
+}
+
+}  // namespace
+
+BENCHMARK(bm_to_string_per_record);
+BENCHMARK(bm_batch);
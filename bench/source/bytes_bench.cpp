@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inspector/bytes.hpp>
+#include <inspector/core.hpp>
+
+namespace {
+
+auto make_payload(std::size_t size) -> std::vector<unsigned char> {
+  std::vector<unsigned char> v(size);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v[i] = static_cast<unsigned char>((i * 131U) ^ (i >> 7U));
+  }
+  return v;
+}
+
+void bm_hex_encode_scalar(benchmark::State& state) {
+  const auto payload = make_payload(static_cast<std::size_t>(state.range(0)));
+  std::string out(2 * payload.size(), '\0');
+  for (auto _ : state) {
+    insp::detail::hex_encode_scalar(payload.data(), payload.size(),
+                                    out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void bm_hex_encode(benchmark::State& state) {
+  const auto payload = make_payload(static_cast<std::size_t>(state.range(0)));
+  std::string out(2 * payload.size(), '\0');
+  for (auto _ : state) {
+    insp::detail::hex_encode(payload.data(), payload.size(), out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void bm_hex_encode_with(benchmark::State& state, insp::detail::hex_isa isa) {
+  if (!insp::detail::hex_isa_supported(isa)) {
+    state.SkipWithError("not supported on this CPU");
+    return;
+  }
+  const auto payload = make_payload(static_cast<std::size_t>(state.range(0)));
+  std::string out(2 * payload.size(), '\0');
+  for (auto _ : state) {
+    insp::detail::hex_encode_with(isa, payload.data(), payload.size(),
+                                  out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void bm_to_string_as_hex(benchmark::State& state) {
+  const auto payload = make_payload(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::to_string(insp::as_hex(payload)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(bm_hex_encode_scalar)->Range(4 << 10, 4 << 20);
+BENCHMARK(bm_hex_encode)->Range(4 << 10, 4 << 20);
+BENCHMARK_CAPTURE(bm_hex_encode_with, sse2, insp::detail::hex_isa::sse2)
+    ->Range(4 << 10, 4 << 20);
+BENCHMARK_CAPTURE(bm_hex_encode_with, ssse3, insp::detail::hex_isa::ssse3)
+    ->Range(4 << 10, 4 << 20);
+BENCHMARK_CAPTURE(bm_hex_encode_with, avx2, insp::detail::hex_isa::avx2)
+    ->Range(4 << 10, 4 << 20);
+BENCHMARK(bm_to_string_as_hex)->Range(4 << 10, 4 << 20);
@@ -0,0 +1,45 @@
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/fingerprint.hpp>
+
+namespace {
+
+auto make_payload() -> std::vector<double> {
+  std::vector<double> v(4096);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v[i] = static_cast<double>(i) * 0.25;
+  }
+  return v;
+}
+
+void bm_hash_to_string(benchmark::State& state) {
+  const auto payload = make_payload();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        insp::fingerprint_text(insp::to_string(payload)));
+  }
+}
+
+void bm_fingerprint(benchmark::State& state) {
+  const auto payload = make_payload();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::fingerprint(payload));
+  }
+}
+
+void bm_binary_fingerprint(benchmark::State& state) {
+  const auto payload = make_payload();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::binary_fingerprint(payload));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(bm_hash_to_string);
+BENCHMARK(bm_fingerprint);
+BENCHMARK(bm_binary_fingerprint);
@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/iterative.hpp>
+#include <inspector/utility.hpp>  // IWYU pragma: keep
+
+namespace {
+
+struct node {
+  int value;
+  std::vector<node> children;
+};
+
+auto inspect_as(const node& n) {
+  return std::tie(n.value, n.children);
+}
+
+// A chain `depth` levels deep with a few leaf siblings at every level.
+auto make_deep_tree(std::size_t depth) -> node {
+  node root{0, {}};
+  auto* cur = &root;
+  for (std::size_t i = 1; i < depth; ++i) {
+    cur->children.push_back({1, {}});
+    cur->children.push_back({2, {}});
+    cur->children.push_back({static_cast<int>(i), {}});
+    cur = &cur->children.back();
+  }
+  return root;
+}
+
+using wide_row = std::vector<std::tuple<int, double, std::string>>;
+using wide_payload = std::vector<std::map<int, wide_row>>;
+
+auto make_wide_payload() -> wide_payload {
+  wide_payload v(64);
+  for (auto& m : v) {
+    for (int k = 0; k < 8; ++k) {
+      m[k] = {{k, 0.5, "x"}, {k + 1, 1.5, "yy"}};
+    }
+  }
+  return v;
+}
+
+void bm_recursive_deep(benchmark::State& state) {
+  const auto tree = make_deep_tree(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::to_string(tree));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_iterative_deep(benchmark::State& state) {
+  const auto tree = make_deep_tree(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::to_string(insp::iterative(tree)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_recursive_wide(benchmark::State& state) {
+  const auto payload = make_wide_payload();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::to_string(payload));
+  }
+}
+
+void bm_iterative_wide(benchmark::State& state) {
+  const auto payload = make_wide_payload();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(insp::to_string(insp::iterative(payload)));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(bm_recursive_deep)->Range(16, 4096);
+BENCHMARK(bm_iterative_deep)->Range(16, 4096);
+BENCHMARK(bm_recursive_wide);
+BENCHMARK(bm_iterative_wide);
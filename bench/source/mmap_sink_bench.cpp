@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/mmap_sink.hpp>
+
+namespace {
+
+auto make_record() -> std::map<std::string, std::vector<int>> {
+  return {{"latency", {12, 15, 11, 230, 14}},
+          {"status", {200, 200, 404}},
+          {"sizes", {512, 1024, 4096, 65536}}};
+}
+
+auto record_size() -> std::int64_t {
+  return static_cast<std::int64_t>(insp::to_string(make_record()).size() + 1);
+}
+
+const auto fwrite_path =
+    (std::filesystem::temp_directory_path() / "inspector_bench_fwrite.log")
+        .string();
+const auto mmap_path =
+    (std::filesystem::temp_directory_path() / "inspector_bench_mmap.log")
+        .string();
+
+// Shared by all threads of one run, created before the threads start.
+std::FILE* shared_file = nullptr;              // NOLINT
+std::unique_ptr<insp::mmap_sink> shared_sink;  // NOLINT
+
+void bm_to_string_fwrite(benchmark::State& state) {
+  const auto record = make_record();
+  for (auto _ : state) {
+    auto line = insp::to_string(record);
+    line += '\n';
+    std::fwrite(line.data(), 1, line.size(), shared_file);
+  }
+  state.SetBytesProcessed(state.iterations() * record_size());
+}
+
+void bm_mmap_writer(benchmark::State& state) {
+  const auto record = make_record();
+  insp::mmap_writer writer(*shared_sink);
+  for (auto _ : state) {
+    writer << insp::make_inspectable(record) << '\n';
+    writer.commit();
+  }
+  state.SetBytesProcessed(state.iterations() * record_size());
+}
+
+}  // namespace
+
+BENCHMARK(bm_to_string_fwrite)
+    ->ThreadRange(1, 4)
+    ->UseRealTime()
+    ->Setup([](const benchmark::State&) {
+      shared_file = std::fopen(fwrite_path.c_str(), "wb");
+    })
+    ->Teardown([](const benchmark::State&) {
+      std::fclose(shared_file);
+      std::filesystem::remove(fwrite_path);
+    });
+
+BENCHMARK(bm_mmap_writer)
+    ->ThreadRange(1, 4)
+    ->UseRealTime()
+    ->Setup([](const benchmark::State&) {
+      shared_sink = std::make_unique<insp::mmap_sink>(mmap_path);
+    })
+    ->Teardown([](const benchmark::State&) {
+      std::vector<std::string> files;
+      for (std::size_t i = 0; i < shared_sink->file_count(); ++i) {
+        files.push_back(shared_sink->file_path(i));
+      }
+      shared_sink.reset();
+      for (const auto& file : files) {
+        std::filesystem::remove(file);
+      }
+    });
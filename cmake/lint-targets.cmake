@@ -3,6 +3,7 @@ set(
     source/*.cpp source/*.hpp
     include/*.hpp
     test/*.cpp test/*.hpp
+    bench/*.cpp bench/*.hpp
     example/*.cpp example/*.hpp
     CACHE STRING
     "; separated patterns relative to the project source dir to format"
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+
+namespace insp {
+namespace detail {
+
+inline constexpr std::size_t any_buffer_size = 48;
+
+union any_storage {
+  alignas(std::max_align_t) std::byte buffer[any_buffer_size];  // NOLINT
+  void* heap;
+};
+
+// Values that are small enough and cheap to relocate live in the inline
+// buffer; everything else is allocated.
+template <typename T>
+constexpr bool fits_inline_v = sizeof(T) <= any_buffer_size &&
+                               alignof(T) <= alignof(std::max_align_t) &&
+                               std::is_nothrow_move_constructible_v<T>;
+
+// The built-in styles each get an entry in the vtable. Other styles cannot
+// be erased, as the inspectors are instantiated per style.
+template <typename Style>
+constexpr bool is_erased_style_v = std::is_same_v<Style, default_style> ||
+                                   std::is_same_v<Style, compact_style> ||
+                                   std::is_same_v<Style, pretty_style>;
+
+template <typename Style>
+constexpr std::size_t erased_style_index = 0;
+
+template <>
+constexpr std::size_t erased_style_index<compact_style> = 1;
+
+template <>
+constexpr std::size_t erased_style_index<pretty_style> = 2;
+
+struct any_vtable {
+  using inspect_fn = auto (*)(const any_storage& self,
+                              std::ostream& os) -> std::ostream&;
+
+  std::array<inspect_fn, 3> inspect;
+  void (*copy)(const any_storage& src, any_storage& dst);
+  void (*move)(any_storage& src, any_storage& dst) noexcept;
+  void (*destroy)(any_storage& self) noexcept;
+  bool stored_inline;
+};
+
+template <typename T>
+struct any_handler {
+  static auto get(any_storage& s) -> T& {
+    if constexpr (fits_inline_v<T>) {
+      return *std::launder(reinterpret_cast<T*>(s.buffer));  // NOLINT
+    } else {
+      return *static_cast<T*>(s.heap);
+    }
+  }
+
+  static auto get(const any_storage& s) -> const T& {
+    return get(const_cast<any_storage&>(s));  // NOLINT(*-const-cast)
+  }
+
+  template <typename... Args>
+  static void create(any_storage& s, Args&&... args) {
+    if constexpr (fits_inline_v<T>) {
+      ::new (static_cast<void*>(s.buffer)) T(std::forward<Args>(args)...);
+    } else {
+      s.heap = new T(std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename Style>
+  static auto inspect(const any_storage& self,
+                      std::ostream& os) -> std::ostream& {
+    return os << make_inspectable<Style>(get(self));
+  }
+
+  static void copy(const any_storage& src, any_storage& dst) {
+    create(dst, get(src));
+  }
+
+  static void move(any_storage& src, any_storage& dst) noexcept {
+    if constexpr (fits_inline_v<T>) {
+      create(dst, std::move(get(src)));
+      destroy(src);
+    } else {
+      dst.heap = src.heap;
+    }
+  }
+
+  static void destroy(any_storage& self) noexcept {
+    if constexpr (fits_inline_v<T>) {
+      std::destroy_at(std::addressof(get(self)));
+    } else {
+      delete static_cast<T*>(self.heap);
+    }
+  }
+
+  static constexpr any_vtable vtable = {
+      {&inspect<default_style>, &inspect<compact_style>,
+       &inspect<pretty_style>},
+      &copy,
+      &move,
+      &destroy,
+      fits_inline_v<T>};
+};
+
+}  // namespace detail
+
+// Type-erased value that inspects like the object it was built from, for
+// passing heterogeneous arguments through non-template interfaces and
+// formatting them later. Values of up to `buffer_size` bytes that are
+// nothrow-movable are stored inline without allocating; larger ones go to
+// the heap. The stored value is a copy, so pointers and views must outlive
+// it. An empty `any_inspectable` writes nothing. Only the built-in styles
+// are supported; inspecting with any other style does not compile.
+class any_inspectable {
+ public:
+  static constexpr std::size_t buffer_size = detail::any_buffer_size;
+
+  any_inspectable() noexcept = default;
+
+  template <typename T,
+            typename U = std::decay_t<T>,
+            typename = std::enable_if_t<!std::is_same_v<U, any_inspectable> &&
+                                        std::is_copy_constructible_v<U>>>
+  any_inspectable(T&& value)  // NOLINT(*-explicit-*)
+      : vtable_(&detail::any_handler<U>::vtable) {
+    detail::any_handler<U>::create(storage_, std::forward<T>(value));
+  }
+
+  any_inspectable(const any_inspectable& other) : vtable_(other.vtable_) {
+    if (vtable_ != nullptr) {
+      vtable_->copy(other.storage_, storage_);
+    }
+  }
+
+  any_inspectable(any_inspectable&& other) noexcept
+      : vtable_(std::exchange(other.vtable_, nullptr)) {
+    if (vtable_ != nullptr) {
+      vtable_->move(other.storage_, storage_);
+    }
+  }
+
+  auto operator=(const any_inspectable& other) -> any_inspectable& {
+    if (this != &other) {
+      any_inspectable(other).swap(*this);
+    }
+    return *this;
+  }
+
+  auto operator=(any_inspectable&& other) noexcept -> any_inspectable& {
+    if (this != &other) {
+      reset();
+      vtable_ = std::exchange(other.vtable_, nullptr);
+      if (vtable_ != nullptr) {
+        vtable_->move(other.storage_, storage_);
+      }
+    }
+    return *this;
+  }
+
+  ~any_inspectable() { reset(); }
+
+  void swap(any_inspectable& other) noexcept {
+    any_inspectable tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  void reset() noexcept {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  auto has_value() const noexcept -> bool { return vtable_ != nullptr; }
+
+  // Whether the value lives in the inline buffer rather than on the heap.
+  auto stored_inline() const noexcept -> bool {
+    return vtable_ != nullptr && vtable_->stored_inline;
+  }
+
+  template <typename Style = default_style>
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    static_assert(detail::is_erased_style_v<Style>,
+                  "any_inspectable supports only default_style, "
+                  "compact_style and pretty_style");
+    if (vtable_ == nullptr) {
+      return os;
+    }
+    return vtable_->inspect[detail::erased_style_index<Style>](storage_, os);
+  }
+
+ private:
+  detail::any_storage storage_ = {};
+  const detail::any_vtable* vtable_ = nullptr;
+};
+
+inline void swap(any_inspectable& lhs, any_inspectable& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace insp
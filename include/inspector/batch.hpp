@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "buffer.hpp"
+#include "core.hpp"
+
+namespace insp {
+
+struct batch_entry {
+  std::size_t offset;
+  std::size_t length;
+};
+
+// Inspects many objects into one arena-backed text buffer, recording an
+// (offset, length) entry per object. All storage comes from a monotonic
+// buffer resource, and a single output stream is reused for every object,
+// so a batch costs a handful of allocations regardless of its size.
+class batch {
+ public:
+  static constexpr std::size_t default_initial_size = 4096;
+
+  explicit batch(
+      std::size_t initial_size = default_initial_size,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : arena_(initial_size, upstream),
+        buf_(std::pmr::vector<char>(&arena_)),
+        entries_(&arena_),
+        os_(&buf_) {}
+
+  batch(const batch&) = delete;
+  batch(batch&&) = delete;
+  auto operator=(const batch&) -> batch& = delete;
+  auto operator=(batch&&) -> batch& = delete;
+  ~batch() = default;
+
+  template <typename T>
+  auto add(const T& obj) -> std::size_t {
+    const auto offset = buf_.size();
+    os_ << make_inspectable(obj);
+    entries_.push_back({offset, buf_.size() - offset});
+    return entries_.size() - 1;
+  }
+
+  template <typename... Ts>
+  void add_all(const Ts&... objs) {
+    entries_.reserve(entries_.size() + sizeof...(Ts));
+    (add(objs), ...);
+  }
+
+  template <typename Range>
+  void add_range(const Range& range) {
+    for (const auto& obj : range) {
+      add(obj);
+    }
+  }
+
+  // Pre-sizes the arena for `bytes` of text and `count` more entries.
+  void reserve(std::size_t bytes, std::size_t count) {
+    buf_.reserve(bytes);
+    entries_.reserve(entries_.size() + count);
+  }
+
+  auto size() const -> std::size_t { return entries_.size(); }
+  auto empty() const -> bool { return entries_.empty(); }
+
+  auto entries() const -> std::span<const batch_entry> { return entries_; }
+
+  // The concatenated output of every object in the batch.
+  auto text() const -> std::string_view { return {buf_.data(), buf_.size()}; }
+
+  // Views are invalidated by the next `add`.
+  auto operator[](std::size_t index) const -> std::string_view {
+    const auto& e = entries_[index];
+    return text().substr(e.offset, e.length);
+  }
+
+  // Forgets all entries but keeps the arena's memory for reuse.
+  void clear() {
+    buf_.reset();
+    entries_.clear();
+    os_.clear();
+  }
+
+ private:
+  std::pmr::monotonic_buffer_resource arena_;
+  detail::container_buf<std::pmr::vector<char>> buf_;
+  std::pmr::vector<batch_entry> entries_;
+  std::ostream os_;
+};
+
+}  // namespace insp
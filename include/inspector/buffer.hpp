@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <streambuf>
+#include <utility>
+
+namespace insp {
+namespace detail {
+
+// `std::streambuf` whose put pointer can be moved by any number of bytes.
+// `pbump` takes an `int`, so a single write or a buffer larger than INT_MAX
+// bytes would overflow it.
+class put_area_buf : public std::streambuf {
+ protected:
+  void advance_put(std::size_t n) {
+    for (; n > INT_MAX; n -= INT_MAX) {
+      pbump(INT_MAX);
+    }
+    pbump(static_cast<int>(n));
+  }
+
+  // Sets the put area to [first, last) with the put pointer at `next`.
+  void setp_at(char* first, char* next, char* last) {
+    setp(first, last);
+    advance_put(static_cast<std::size_t>(next - first));
+  }
+};
+
+// Stream buffer appending to a contiguous, resizable char container such as
+// `std::vector<char>` or `std::pmr::vector<char>`. The put area spans the
+// whole container, so only `size()` of it holds output.
+template <typename Container>
+class container_buf : public put_area_buf {
+ public:
+  explicit container_buf(Container storage = Container())
+      : storage_(std::move(storage)) {}
+
+  auto data() const -> const char* { return storage_.data(); }
+  auto size() const -> std::size_t {
+    return static_cast<std::size_t>(pptr() - pbase());
+  }
+
+  void reserve(std::size_t capacity) {
+    if (capacity > storage_.size()) {
+      resize(capacity);
+    }
+  }
+
+  void reset() {
+    setp(storage_.data(), storage_.data() + storage_.size());
+  }
+
+ protected:
+  auto overflow(int_type ch) -> int_type override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    grow(1);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+  }
+
+  auto xsputn(const char_type* s, std::streamsize count)
+      -> std::streamsize override {
+    const auto n = static_cast<std::size_t>(count);
+    if (n > static_cast<std::size_t>(epptr() - pptr())) {
+      grow(n);
+    }
+    traits_type::copy(pptr(), s, n);
+    advance_put(n);
+    return count;
+  }
+
+ private:
+  static constexpr std::size_t initial_size = 256;
+
+  void grow(std::size_t extra) {
+    resize(std::max({storage_.size() * 2, size() + extra, initial_size}));
+  }
+
+  void resize(std::size_t capacity) {
+    const auto used = size();
+    storage_.resize(capacity);
+    setp_at(storage_.data(), storage_.data() + used,
+            storage_.data() + storage_.size());
+  }
+
+  Container storage_;
+};
+
+}  // namespace detail
+}  // namespace insp
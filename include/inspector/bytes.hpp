@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER) && \
+    (defined(__x86_64__) || defined(__i386__))
+// GCC and Clang build every x86 path with a per-function target attribute
+// and choose one at run time.
+#  define INSP_HEX_DISPATCH 1
+#  define INSP_HEX_TARGET(isa) __attribute__((target(isa)))
+#  include <immintrin.h>
+#else
+#  define INSP_HEX_TARGET(isa)
+#  if defined(__AVX2__) || defined(__SSSE3__)
+#    include <immintrin.h>
+#  elif defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#  endif
+#endif
+
+#if defined(INSP_HEX_DISPATCH) || defined(__SSE2__) || defined(_M_X64)
+#  define INSP_HEX_SSE2 1
+#endif
+#if defined(INSP_HEX_DISPATCH) || defined(__SSSE3__) || defined(__AVX2__)
+#  define INSP_HEX_SSSE3 1
+#endif
+#if defined(INSP_HEX_DISPATCH) || defined(__AVX2__)
+#  define INSP_HEX_AVX2 1
+#endif
+
+#include "containers.hpp"
+#include "core.hpp"
+
+namespace insp {
+namespace detail {
+
+constexpr std::array<char, 16> hex_digits = {'0', '1', '2', '3', '4', '5',
+                                             '6', '7', '8', '9', 'a', 'b',
+                                             'c', 'd', 'e', 'f'};
+
+// Writes 2 * size lowercase hex digits to `dst`.
+inline void hex_encode_scalar(const unsigned char* src,
+                              std::size_t size,
+                              char* dst) {
+  for (std::size_t i = 0; i < size; ++i) {
+    dst[2 * i] = hex_digits[src[i] >> 4U];
+    dst[(2 * i) + 1] = hex_digits[src[i] & 0x0FU];
+  }
+}
+
+// Vector units `hex_encode` can use.
+enum class hex_isa { scalar, sse2, ssse3, avx2 };
+
+// The `hex_encode_<isa>` functions encode whole blocks only and return the
+// number of bytes consumed. AVX2 and SSSE3 look nibbles up with a byte
+// shuffle, SSE2 computes them with a compare-and-add.
+// NOLINTBEGIN(*-reinterpret-cast)
+#if defined(INSP_HEX_SSE2)
+INSP_HEX_TARGET("sse2")
+inline auto load128(const unsigned char* p) -> __m128i {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+INSP_HEX_TARGET("sse2")
+inline void store128(char* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+INSP_HEX_TARGET("sse2")
+inline auto hex_digits_sse2(__m128i nibbles) -> __m128i {
+  const __m128i letters = _mm_and_si128(
+      _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+  return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+INSP_HEX_TARGET("sse2")
+inline auto hex_encode_sse2(const unsigned char* src,
+                            std::size_t size,
+                            char* dst) -> std::size_t {
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = load128(src + i);
+    const __m128i hi =
+        hex_digits_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    const __m128i lo = hex_digits_sse2(_mm_and_si128(v, mask));
+    store128(dst + (2 * i), _mm_unpacklo_epi8(hi, lo));
+    store128(dst + (2 * i) + 16, _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+#endif
+
+#if defined(INSP_HEX_SSSE3)
+INSP_HEX_TARGET("ssse3")
+inline auto hex_encode_ssse3(const unsigned char* src,
+                             std::size_t size,
+                             char* dst) -> std::size_t {
+  const __m128i table = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = load128(src + i);
+    const __m128i hi =
+        _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+    store128(dst + (2 * i), _mm_unpacklo_epi8(hi, lo));
+    store128(dst + (2 * i) + 16, _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+#endif
+
+#if defined(INSP_HEX_AVX2)
+INSP_HEX_TARGET("avx2")
+inline auto load256(const unsigned char* p) -> __m256i {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+INSP_HEX_TARGET("avx2")
+inline void store256(char* p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+INSP_HEX_TARGET("avx2")
+inline auto hex_encode_avx2(const unsigned char* src,
+                            std::size_t size,
+                            char* dst) -> std::size_t {
+  const __m256i table = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+      'e', 'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+      'd', 'e', 'f');
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i v = load256(src + i);
+    const __m256i hi = _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, mask));
+    // Unpacking works per 128-bit lane; permute the halves back in order.
+    const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    store256(dst + (2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+    store256(dst + (2 * i) + 32, _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i + hex_encode_ssse3(src + i, size - i, dst + (2 * i));
+}
+#endif
+// NOLINTEND(*-reinterpret-cast)
+
+// Whether `isa` was built and, where it is chosen at run time, whether the
+// CPU has it.
+inline auto hex_isa_supported(hex_isa isa) -> bool {
+  switch (isa) {
+    case hex_isa::scalar:
+      return true;
+#if defined(INSP_HEX_DISPATCH)
+    case hex_isa::sse2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse2") != 0;
+    case hex_isa::ssse3:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("ssse3") != 0;
+    case hex_isa::avx2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") != 0;
+#else
+#  if defined(INSP_HEX_SSE2)
+    case hex_isa::sse2:
+#  endif
+#  if defined(INSP_HEX_SSSE3)
+    case hex_isa::ssse3:
+#  endif
+#  if defined(INSP_HEX_AVX2)
+    case hex_isa::avx2:
+#  endif
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+inline auto best_hex_isa() -> hex_isa {
+  static const hex_isa best = [] {
+    for (const auto isa : {hex_isa::avx2, hex_isa::ssse3, hex_isa::sse2}) {
+      if (hex_isa_supported(isa)) {
+        return isa;
+      }
+    }
+    return hex_isa::scalar;
+  }();
+  return best;
+}
+
+// Same as `hex_encode_scalar` on the given vector unit, which must be
+// supported.
+inline void hex_encode_with(hex_isa isa,
+                            const unsigned char* src,
+                            std::size_t size,
+                            char* dst) {
+  std::size_t i = 0;
+  switch (isa) {
+#if defined(INSP_HEX_AVX2)
+    case hex_isa::avx2:
+      i = hex_encode_avx2(src, size, dst);
+      break;
+#endif
+#if defined(INSP_HEX_SSSE3)
+    case hex_isa::ssse3:
+      i = hex_encode_ssse3(src, size, dst);
+      break;
+#endif
+#if defined(INSP_HEX_SSE2)
+    case hex_isa::sse2:
+      i = hex_encode_sse2(src, size, dst);
+      break;
+#endif
+    default:
+      break;
+  }
+  hex_encode_scalar(src + i, size - i, dst + (2 * i));
+}
+
+// Same as `hex_encode_scalar`, using the widest vector unit available.
+inline void hex_encode(const unsigned char* src,
+                       std::size_t size,
+                       char* dst) {
+  hex_encode_with(best_hex_isa(), src, size, dst);
+}
+
+inline auto write_hex(std::ostream& os,
+                      const unsigned char* data,
+                      std::size_t size) -> std::ostream& {
+  constexpr std::size_t chunk = 1024;
+  std::array<char, 2 * chunk> buf{};
+  for (std::size_t i = 0; i < size; i += chunk) {
+    const auto n = std::min(chunk, size - i);
+    hex_encode(data + i, n, buf.data());
+    os.write(buf.data(), static_cast<std::streamsize>(2 * n));
+  }
+  return os;
+}
+
+// `xxd`-style dump: offset, 16 bytes in groups of two, then the printable
+// ASCII characters. Lines are separated, not terminated, by newlines.
+inline auto write_hexdump(std::ostream& os,
+                          const unsigned char* data,
+                          std::size_t size) -> std::ostream& {
+  constexpr std::size_t per_line = 16;
+  // "00000000: " + 8 groups of "xxxx " + " " + 16 ASCII characters
+  constexpr std::size_t hex_column = 10;
+  constexpr std::size_t ascii_column = hex_column + (per_line / 2 * 5) + 1;
+  std::array<char, ascii_column + per_line + 1> line{};
+  std::array<char, 2 * per_line> hex{};
+
+  for (std::size_t offset = 0; offset < size; offset += per_line) {
+    const auto n = std::min(per_line, size - offset);
+    std::fill(line.begin(), line.end(), ' ');
+    auto pos = static_cast<std::uint32_t>(offset);
+    for (std::size_t i = 8; i-- > 0; pos >>= 4U) {
+      line[i] = hex_digits[pos & 0x0FU];
+    }
+    line[8] = ':';
+
+    hex_encode(data + offset, n, hex.data());
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto col = hex_column + (i / 2 * 5) + (i % 2 * 2);
+      line[col] = hex[2 * i];
+      line[col + 1] = hex[(2 * i) + 1];
+      const auto c = data[offset + i];
+      line[ascii_column + i] =
+          c >= 0x20 && c < 0x7F ? static_cast<char>(c) : '.';
+    }
+
+    if (offset != 0) {
+      os.put('\n');
+    }
+    os.write(line.data(), static_cast<std::streamsize>(ascii_column + n));
+  }
+  return os;
+}
+
+template <typename T>
+constexpr bool is_byte_like_v =
+    sizeof(T) == 1 &&
+    (std::is_same_v<T, std::byte> || std::is_same_v<T, unsigned char> ||
+     std::is_same_v<T, signed char> || std::is_same_v<T, char>);
+
+template <typename Range>
+  requires std::ranges::contiguous_range<const Range> &&
+           std::ranges::sized_range<const Range> &&
+           is_byte_like_v<std::ranges::range_value_t<const Range>>
+struct hex_view {
+  const Range* range;
+  bool dump;
+
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    const auto* data = reinterpret_cast<const unsigned char*>(  // NOLINT
+        std::ranges::data(*range));
+    const auto size = static_cast<std::size_t>(std::ranges::size(*range));
+    return dump ? write_hexdump(os, data, size) : write_hex(os, data, size);
+  }
+};
+
+}  // namespace detail
+
+template <>
+struct inspector<std::byte> {
+  static auto inspect(std::ostream& os, std::byte obj) -> std::ostream& {
+    const auto b = static_cast<unsigned char>(obj);
+    return detail::write_hex(os, &b, 1);
+  }
+};
+
+// Compact lowercase hex of any contiguous range of bytes, e.g. `0aff10`.
+template <typename Range>
+auto as_hex(const Range& range) -> detail::hex_view<Range> {
+  return {&range, false};
+}
+
+// Vectors and arrays of `std::byte`, `unsigned char` and `std::uint8_t` are
+// shown as compact hex instead of one element per byte.
+template <typename T>
+  requires detail::is_hex_byte_v<T>
+struct inspector<std::vector<T>> {
+  static auto inspect(std::ostream& os,
+                      const std::vector<T>& obj) -> std::ostream& {
+    return os << make_inspectable(as_hex(obj));
+  }
+};
+
+template <typename T, std::size_t N>
+  requires detail::is_hex_byte_v<T>
+struct inspector<std::array<T, N>> {
+  static auto inspect(std::ostream& os,
+                      const std::array<T, N>& obj) -> std::ostream& {
+    return os << make_inspectable(as_hex(obj));
+  }
+};
+
+// Multi-line `xxd`-style dump of any contiguous range of bytes.
+template <typename Range>
+auto as_hexdump(const Range& range) -> detail::hex_view<Range> {
+  return {&range, true};
+}
+
+}  // namespace insp
+
+#undef INSP_HEX_AVX2
+#undef INSP_HEX_SSSE3
+#undef INSP_HEX_SSE2
+#undef INSP_HEX_TARGET
+#undef INSP_HEX_DISPATCH
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <array>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
 #include <ratio>
 #include <string_view>
+#include <type_traits>
 
 #include "core.hpp"
 
@@ -74,4 +81,222 @@ struct inspector<std::chrono::duration<Rep, Period>> {
   }
 };
 
+namespace detail {
+
+// Writes `[-]sec.nsec` seconds in the most readable unit using integer
+// arithmetic only: below a minute as a value with two decimals in the
+// largest unit that keeps it at least 1 (`123.46ms`), from a minute on as
+// whole components (`1h02m03s`, `2d00h00m05s`).
+inline auto write_humanized(std::ostream& os,
+                            bool negative,
+                            std::uint64_t sec,
+                            std::uint32_t nsec) -> std::ostream& {
+  constexpr std::uint64_t ns_per_sec = 1'000'000'000;
+  std::array<char, 64> buf{};
+  char* out = buf.data();
+  char* const end = buf.data() + buf.size();
+
+  // The output always fits; the bound check only keeps GCC's
+  // -Wstringop-overflow from flagging the stores at -O3.
+  const auto put_char = [&](char c) {
+    if (out != end) {
+      *out++ = c;
+    }
+  };
+  const auto put_number = [&](std::uint64_t n, int min_digits) {
+    if (min_digits == 2 && n < 10) {
+      put_char('0');
+    }
+    out = std::to_chars(out, end, n).ptr;
+  };
+  const auto put_unit = [&](std::string_view unit) {
+    for (const char c : unit) {
+      put_char(c);
+    }
+  };
+  // Inserted as a whole so that the stream's width pads it and is reset.
+  const auto finish = [&]() -> std::ostream& {
+    return os << std::string_view(
+               buf.data(), static_cast<std::size_t>(out - buf.data()));
+  };
+
+  if (sec == 0 && nsec == 0) {
+    put_number(0, 1);
+    put_unit(duration_unit::second);
+    return finish();
+  }
+  if (negative) {
+    put_char('-');
+  }
+
+  if (sec < 60) {
+    const std::uint64_t total = (sec * ns_per_sec) + nsec;
+    if (total < 1000) {
+      put_number(total, 1);
+      put_unit(duration_unit::nanosecond);
+      return finish();
+    }
+    struct scaled_unit {
+      std::uint64_t scale;
+      std::string_view name;
+    };
+    constexpr std::array<scaled_unit, 3> units{{
+        {1'000, duration_unit::microsecond},
+        {1'000'000, duration_unit::millisecond},
+        {ns_per_sec, duration_unit::second},
+    }};
+    for (const auto& unit : units) {
+      const auto hundredths = ((total * 100) + (unit.scale / 2)) / unit.scale;
+      // Rounding may carry into the next unit, e.g. 999.996us -> 1.00ms.
+      const bool fits = unit.scale == ns_per_sec ? hundredths < 6'000
+                                                 : hundredths < 100'000;
+      if (fits) {
+        put_number(hundredths / 100, 1);
+        put_char('.');
+        put_number(hundredths % 100, 2);
+        put_unit(unit.name);
+        return finish();
+      }
+    }
+  }
+
+  // Round to whole seconds; 59.996s ends up here as 1m00s.
+  if (nsec >= ns_per_sec / 2) {
+    ++sec;
+  }
+  const auto days = sec / 86400;
+  const auto hours = sec / 3600 % 24;
+  const auto minutes = sec / 60 % 60;
+  const auto seconds = sec % 60;
+  int width = 1;
+  if (days > 0) {
+    put_number(days, width);
+    put_unit(duration_unit::day);
+    width = 2;
+  }
+  if (days > 0 || hours > 0) {
+    put_number(hours, width);
+    put_unit(duration_unit::hour);
+    width = 2;
+  }
+  put_number(minutes, width);
+  put_char('m');
+  put_number(seconds, 2);
+  put_unit(duration_unit::second);
+  return finish();
+}
+
+// Splits `ticks` of `Period` into whole seconds and a rounded nanosecond
+// remainder using unsigned arithmetic only, so that no count of any period
+// can overflow. Returns false when the seconds do not fit in 64 bits.
+template <typename Period>
+auto split_ticks(std::uint64_t ticks,
+                 std::uint64_t& sec,
+                 std::uint32_t& nsec) -> bool {
+  constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+  constexpr std::uint64_t ns_per_sec = 1'000'000'000;
+  constexpr auto num = static_cast<std::uint64_t>(Period::num);
+  constexpr auto den = static_cast<std::uint64_t>(Period::den);
+
+  const auto whole = ticks / den;
+  const auto rest = ticks % den;
+  if (whole > max / num || rest > max / num) {
+    return false;
+  }
+  // `rest * num / den` is below `num`, the leftover below `den`.
+  const auto scaled = rest * num;
+  sec = whole * num;
+  if (scaled / den > max - sec) {
+    return false;
+  }
+  sec += scaled / den;
+
+  const auto frac = scaled % den;
+  std::uint64_t ns = 0;
+  if constexpr (den <= max / ns_per_sec) {
+    ns = ((frac * ns_per_sec) + (den / 2)) / den;
+  } else if constexpr (den % ns_per_sec == 0) {
+    constexpr auto step = den / ns_per_sec;
+    ns = (frac + (step / 2)) / step;
+  } else {
+    ns = static_cast<std::uint64_t>(std::llround(
+        static_cast<double>(frac) / static_cast<double>(den) * 1e9));
+  }
+  if (ns == ns_per_sec) {  // sub-nanosecond periods may round up
+    if (sec == max) {
+      return false;
+    }
+    ++sec;
+    ns = 0;
+  }
+  nsec = static_cast<std::uint32_t>(ns);
+  return true;
+}
+
+template <typename Rep, typename Period>
+struct humanized_duration {
+  std::chrono::duration<Rep, Period> value;
+
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    using std::chrono::nanoseconds;
+    using std::chrono::seconds;
+
+    // Unsigned negation keeps the most negative count representable.
+    const auto magnitude = [](auto n) -> std::uint64_t {
+      if constexpr (std::is_signed_v<decltype(n)>) {
+        if (n < 0) {
+          return 0 - static_cast<std::uint64_t>(n);
+        }
+      }
+      return static_cast<std::uint64_t>(n);
+    };
+
+    if constexpr (std::is_floating_point_v<Rep>) {
+      // Values that do not fit the integer form keep the raw notation, in
+      // seconds so that every period gets a unit. The limit is compared in
+      // `double`, which holds it exactly unlike `float`.
+      constexpr double max_seconds = 1e15;
+      const auto secs = std::chrono::duration<Rep>(value);
+      if (!std::isfinite(secs.count()) ||
+          std::abs(static_cast<double>(secs.count())) >= max_seconds) {
+        return inspector<std::chrono::duration<Rep>>::inspect(os, secs);
+      }
+
+      // Below the limit whole seconds and nanoseconds fit `int64_t`.
+      const auto whole = std::chrono::duration_cast<seconds>(value);
+      const auto frac = std::chrono::round<nanoseconds>(value - whole);
+      auto sec = magnitude(whole.count());
+      auto nsec = static_cast<std::uint32_t>(magnitude(frac.count()));
+      if (nsec == 1'000'000'000) {
+        ++sec;
+        nsec = 0;
+      }
+      const bool negative = whole.count() < 0 || frac.count() < 0;
+      return write_humanized(os, negative, sec, nsec);
+    } else {
+      std::uint64_t sec = 0;
+      std::uint32_t nsec = 0;
+      if (!split_ticks<Period>(magnitude(value.count()), sec, nsec)) {
+        const std::chrono::duration<double> secs = value;
+        return inspector<std::chrono::duration<double>>::inspect(os, secs);
+      }
+      bool negative = false;
+      if constexpr (std::is_signed_v<Rep>) {
+        negative = value.count() < 0;
+      }
+      return write_humanized(os, negative, sec, nsec);
+    }
+  }
+};
+
+}  // namespace detail
+
+// Opt-in readable form of a duration, e.g. `123.46ms` or `1h02m03s`, for
+// any representation and period.
+template <typename Rep, typename Period>
+auto humanized(const std::chrono::duration<Rep, Period>& d)
+    -> detail::humanized_duration<Rep, Period> {
+  return {d};
+}
+
 }  // namespace insp
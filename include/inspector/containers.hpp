@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <deque>
 #include <forward_list>
 #include <list>
@@ -9,6 +10,7 @@
 #include <queue>
 #include <set>
 #include <stack>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -18,197 +20,243 @@
 namespace insp {
 namespace detail {
 
-template <typename Iter>
+// Element types whose vectors and arrays are byte buffers, inspected as hex.
+template <typename T>
+constexpr bool is_hex_byte_v =
+    std::is_same_v<T, std::byte> || std::is_same_v<T, unsigned char>;
+
+// Containers that inspect as hex by default and therefore carry no
+// brackets.
+template <typename T>
+constexpr bool is_byte_range_v = false;
+
+template <typename T>
+constexpr bool is_byte_range_v<std::vector<T>> = is_hex_byte_v<T>;
+
+template <typename T, std::size_t N>
+constexpr bool is_byte_range_v<std::array<T, N>> = is_hex_byte_v<T>;
+
+template <typename Style, typename Iter>
 auto array_like_inspect(std::ostream& os,
                         Iter begin,
                         Iter end) -> std::ostream& {
-  os << '[';
-  if (begin != end) {
-    os << make_inspectable(*begin++);
+  const bool empty = begin == end;
+  const indent_guard<Style> guard(os);
+  write_open<Style>(os, '[', empty);
+  if (!empty) {
+    os << make_inspectable<Style>(*begin++);
     for (auto it = begin; it != end; ++it) {
-      os << ", " << make_inspectable(*it);
+      write_separator<Style>(os);
+      os << make_inspectable<Style>(*it);
     }
   }
-  os << ']';
+  write_close<Style>(os, ']', empty);
   return os;
 }
 
-template <typename MapIter>
+template <typename Style, typename MapIter>
 auto map_like_inspect(std::ostream& os,
                       MapIter begin,
                       MapIter end) -> std::ostream& {
-  os << '{';
-  if (begin != end) {
-    os << make_inspectable(begin->first) << ": "
-       << make_inspectable(begin->second);
+  const bool empty = begin == end;
+  const indent_guard<Style> guard(os);
+  write_open<Style>(os, '{', empty);
+  if (!empty) {
+    os << make_inspectable<Style>(begin->first) << Style::key_separator
+       << make_inspectable<Style>(begin->second);
     ++begin;
     for (auto it = begin; it != end; ++it) {
-      os << ", " << make_inspectable(it->first) << ": "
-         << make_inspectable(it->second);
+      write_separator<Style>(os);
+      os << make_inspectable<Style>(it->first) << Style::key_separator
+         << make_inspectable<Style>(it->second);
+    }
+  }
+  write_close<Style>(os, '}', empty);
+  return os;
+}
+
+// Container adapters are inspected through a copy, as reading them is
+// destructive. `Next` reads the element the adapter exposes next.
+template <typename Style, typename Adapter, typename Next>
+auto adapter_inspect(std::ostream& os,
+                     Adapter copy,
+                     Next next) -> std::ostream& {
+  const bool empty = copy.empty();
+  const indent_guard<Style> guard(os);
+  write_open<Style>(os, '[', empty);
+  if (!empty) {
+    os << make_inspectable<Style>(next(copy));
+    copy.pop();
+    while (!copy.empty()) {
+      write_separator<Style>(os);
+      os << make_inspectable<Style>(next(copy));
+      copy.pop();
     }
   }
-  os << '}';
+  write_close<Style>(os, ']', empty);
   return os;
 }
 
 }  // namespace detail
 
 template <typename T>
+  requires(!detail::is_hex_byte_v<T>)
 struct inspector<std::vector<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::vector<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T, std::size_t N>
+  requires(!detail::is_hex_byte_v<T>)
 struct inspector<std::array<T, N>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::array<T, N>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
+// Byte buffers are shown as compact hex. Their inspectors are defined in
+// bytes.hpp, which has to be included to inspect them; this keeps the
+// vectorized encoder out of translation units that do not need it.
+template <typename T>
+  requires detail::is_hex_byte_v<T>
+struct inspector<std::vector<T>>;
+
+template <typename T, std::size_t N>
+  requires detail::is_hex_byte_v<T>
+struct inspector<std::array<T, N>>;
+
 template <typename T>
 struct inspector<std::deque<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::deque<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::forward_list<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::forward_list<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::list<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::list<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename K, typename V>
 struct inspector<std::map<K, V>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::map<K, V>& obj) -> std::ostream& {
-    return detail::map_like_inspect(os, obj.begin(), obj.end());
+    return detail::map_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename K, typename V>
 struct inspector<std::unordered_map<K, V>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::unordered_map<K, V>& obj) -> std::ostream& {
-    return detail::map_like_inspect(os, obj.begin(), obj.end());
+    return detail::map_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename K, typename V>
 struct inspector<std::multimap<K, V>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::multimap<K, V>& obj) -> std::ostream& {
-    return detail::map_like_inspect(os, obj.begin(), obj.end());
+    return detail::map_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename K, typename V>
 struct inspector<std::unordered_multimap<K, V>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::unordered_multimap<K, V>& obj)
       -> std::ostream& {
-    return detail::map_like_inspect(os, obj.begin(), obj.end());
+    return detail::map_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::set<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::set<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::unordered_set<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::unordered_set<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::multiset<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::multiset<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::unordered_multiset<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::unordered_multiset<T>& obj) -> std::ostream& {
-    return detail::array_like_inspect(os, obj.begin(), obj.end());
+    return detail::array_like_inspect<Style>(os, obj.begin(), obj.end());
   }
 };
 
 template <typename T>
 struct inspector<std::stack<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::stack<T>& obj) -> std::ostream& {
-    auto copy = obj;  // Explicit copy as the inspection is destructive
-    os << '[';
-    if (!copy.empty()) {
-      os << make_inspectable(copy.top());
-      copy.pop();
-      while (!copy.empty()) {
-        os << ", " << make_inspectable(copy.top());
-        copy.pop();
-      }
-    }
-    return os << ']';
+    return detail::adapter_inspect<Style>(
+        os, obj, [](const auto& c) -> const T& { return c.top(); });
   }
 };
 
 template <typename T>
 struct inspector<std::queue<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::queue<T>& obj) -> std::ostream& {
-    auto copy = obj;  // Explicit copy as the inspection is destructive
-    os << '[';
-    if (!copy.empty()) {
-      os << make_inspectable(copy.front());
-      copy.pop();
-      while (!copy.empty()) {
-        os << ", " << make_inspectable(copy.front());
-        copy.pop();
-      }
-    }
-    return os << ']';
+    return detail::adapter_inspect<Style>(
+        os, obj, [](const auto& c) -> const T& { return c.front(); });
   }
 };
 
 template <typename T>
 struct inspector<std::priority_queue<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::priority_queue<T>& obj) -> std::ostream& {
-    auto copy = obj;  // Explicit copy as the inspection is destructive
-    os << '[';
-    if (!copy.empty()) {
-      os << make_inspectable(copy.top());
-      copy.pop();
-      while (!copy.empty()) {
-        os << ", " << make_inspectable(copy.top());
-        copy.pop();
-      }
-    }
-    return os << ']';
+    return detail::adapter_inspect<Style>(
+        os, obj, [](const auto& c) -> const T& { return c.top(); });
   }
 };
 
@@ -2,7 +2,12 @@
 
 #include <ostream>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
+
+#include "style.hpp"
 
 namespace insp {
 
@@ -15,6 +20,41 @@ struct inspector {
 
 namespace detail {
 
+// Implemented by stream buffers that can take string leaves by reference
+// instead of copying them. Such a buffer registers itself in the stream's
+// pword slot returned by `string_leaf_sink_index()`. `buf` is the stream's
+// current buffer, so a sink can decline when the stream was redirected.
+class string_leaf_sink {
+ public:
+  virtual auto put_reference(const std::streambuf* buf,
+                             std::string_view str) -> bool = 0;
+
+ protected:
+  string_leaf_sink() = default;
+  string_leaf_sink(const string_leaf_sink&) = default;
+  string_leaf_sink(string_leaf_sink&&) = default;
+  auto operator=(const string_leaf_sink&) -> string_leaf_sink& = default;
+  auto operator=(string_leaf_sink&&) -> string_leaf_sink& = default;
+  ~string_leaf_sink() = default;
+};
+
+inline auto string_leaf_sink_index() -> int {
+  static const int index = std::ios_base::xalloc();
+  return index;
+}
+
+// A padded leaf is written normally, so the width is applied and reset.
+inline auto put_string_leaf(std::ostream& os,
+                            std::string_view str) -> std::ostream& {
+  auto* sink = static_cast<string_leaf_sink*>(
+      os.pword(string_leaf_sink_index()));
+  if (sink != nullptr && os.width() == 0 &&
+      sink->put_reference(os.rdbuf(), str)) {
+    return os;
+  }
+  return os << str;
+}
+
 template <typename T, typename = void, typename = void>
 constexpr bool has_inspect_member = false;
 
@@ -41,19 +81,70 @@ constexpr bool has_adl_inspect<
                        decltype(inspect(std::declval<std::ostream&>(),
                                         std::declval<const T&>()))>>> = true;
 
+// `inspect_as(obj)` found by ADL returns another object, typically a tuple
+// of references to members, that `obj` is inspected as. Unlike `inspect`,
+// it exposes the structure, so recursive user types can be traversed
+// iteratively.
+template <typename T, typename = void>
+constexpr bool has_adl_inspect_as = false;
+
+template <typename T>
+constexpr bool has_adl_inspect_as<
+    T,
+    std::void_t<decltype(inspect_as(std::declval<const T&>()))>> = true;
+
+// Styled hooks: a member `inspect<Style>(os)` or an `inspector<T>` whose
+// `inspect` is a template over the style.
+template <typename T, typename Style, typename = void>
+constexpr bool has_styled_inspect_member = false;
+
+template <typename T, typename Style>
+constexpr bool has_styled_inspect_member<
+    T,
+    Style,
+    std::void_t<decltype(std::declval<const T&>().template inspect<Style>(
+        std::declval<std::ostream&>()))>> = true;
+
+template <typename T, typename Style, typename = void>
+constexpr bool has_styled_inspector = false;
+
+template <typename T, typename Style>
+constexpr bool has_styled_inspector<
+    T,
+    Style,
+    std::void_t<decltype(inspector<T>::template inspect<Style>(
+        std::declval<std::ostream&>(),
+        std::declval<const T&>()))>> = true;
+
+template <typename T, typename = void>
+constexpr bool is_tuple_like_v = false;
+
 template <typename T>
+constexpr bool
+    is_tuple_like_v<T, std::void_t<decltype(std::tuple_size<T>::value)>> =
+        true;
+
+template <typename T, typename Style = default_style>
 struct inspectee_wrapper {
   const T* obj;
   explicit inspectee_wrapper(const T& object) : obj(&object) {}
 };
 
-template <typename T>
+template <typename T, typename Style>
 auto operator<<(std::ostream& os,
-                const inspectee_wrapper<T>& insp) -> std::ostream& {
-  if constexpr (has_inspect_member<T>) {
+                const inspectee_wrapper<T, Style>& insp) -> std::ostream& {
+  if constexpr (has_styled_inspect_member<T, Style>) {
+    return insp.obj->template inspect<Style>(os);
+  } else if constexpr (has_inspect_member<T>) {
     return insp.obj->inspect(os);
   } else if constexpr (has_adl_inspect<T>) {
     return inspect(os, *insp.obj);
+  } else if constexpr (has_adl_inspect_as<T>) {
+    const auto& view = inspect_as(*insp.obj);
+    return os << inspectee_wrapper<std::remove_cvref_t<decltype(view)>, Style>(
+               view);
+  } else if constexpr (has_styled_inspector<T, Style>) {
+    return inspector<T>::template inspect<Style>(os, *insp.obj);
   } else {
     return inspector<T>::inspect(os, *insp.obj);
   }
@@ -61,15 +152,43 @@ auto operator<<(std::ostream& os,
 
 }  // namespace detail
 
-template <typename T>
-auto make_inspectable(const T& obj) -> detail::inspectee_wrapper<T> {
-  return detail::inspectee_wrapper<T>(obj);
+template <typename Alloc>
+struct inspector<std::basic_string<char, std::char_traits<char>, Alloc>> {
+  static auto inspect(
+      std::ostream& os,
+      const std::basic_string<char, std::char_traits<char>, Alloc>& obj)
+      -> std::ostream& {
+    return detail::put_string_leaf(os, obj);
+  }
+};
+
+template <>
+struct inspector<std::string_view> {
+  static auto inspect(std::ostream& os,
+                      std::string_view obj) -> std::ostream& {
+    return detail::put_string_leaf(os, obj);
+  }
+};
+
+// `Style` is one of `default_style`, `compact_style`, `pretty_style` or a
+// user-defined struct with the same members, e.g.
+// `make_inspectable<insp::compact_style>(obj)`. The inspected type is always
+// deduced from the argument.
+template <typename Style = default_style, typename T>
+auto make_inspectable(const T& obj) -> detail::inspectee_wrapper<T, Style> {
+  static_assert(is_style_v<Style>,
+                "the template argument of make_inspectable is a style; "
+                "the inspected type is deduced from the argument");
+  return detail::inspectee_wrapper<T, Style>(obj);
 }
 
-template <typename T>
+template <typename Style = default_style, typename T>
 auto to_string(const T& obj) -> std::string {
+  static_assert(is_style_v<Style>,
+                "the template argument of to_string is a style; "
+                "the inspected type is deduced from the argument");
   std::stringstream ss;
-  ss << make_inspectable(obj);
+  ss << make_inspectable<Style>(obj);
   return ss.str();
 }
 
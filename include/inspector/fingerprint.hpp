@@ -0,0 +1,340 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <streambuf>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+#include "optional.hpp"
+
+namespace insp {
+namespace detail {
+
+// Streaming XXH64. The put area is a small stripe buffer inside the hash
+// state, so inspectors write straight into it and nothing is allocated.
+class xxh64_buf : public std::streambuf {
+ public:
+  explicit xxh64_buf(std::uint64_t seed = 0) { reset(seed); }
+
+  void reset(std::uint64_t seed = 0) {
+    seed_ = seed;
+    acc_[0] = seed + prime1 + prime2;
+    acc_[1] = seed + prime2;
+    acc_[2] = seed;
+    acc_[3] = seed - prime1;
+    consumed_ = 0;
+    setp(buffer_, buffer_ + buffer_size);
+  }
+
+  void update(const void* data, std::size_t size) {
+    sputn(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  }
+
+  // Total number of bytes hashed so far.
+  auto length() const -> std::uint64_t { return consumed_ + buffered(); }
+
+  auto digest() const -> std::uint64_t {
+    // Whole stripes still in the buffer are folded into a copy of the state.
+    const auto pending = buffered();
+    const auto full = pending - (pending % stripe_size);
+    auto acc = acc_;
+    auto consumed = consumed_;
+    for (std::size_t i = 0; i < full; i += stripe_size) {
+      consume_stripe(acc, buffer_ + i);
+      consumed += stripe_size;
+    }
+
+    std::uint64_t h = 0;
+    if (consumed > 0) {
+      h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12) +
+          std::rotl(acc[3], 18);
+      for (const auto a : acc) {
+        h = (h ^ round(0, a)) * prime1 + prime4;
+      }
+    } else {
+      h = seed_ + prime5;
+    }
+    h += length();
+
+    const auto* p = buffer_ + full;
+    auto remaining = pending - full;
+    for (; remaining >= 8; remaining -= 8, p += 8) {
+      h = std::rotl(h ^ round(0, read64(p)), 27) * prime1 + prime4;
+    }
+    if (remaining >= 4) {
+      h = std::rotl(h ^ (read32(p) * prime1), 23) * prime2 + prime3;
+      remaining -= 4;
+      p += 4;
+    }
+    for (; remaining > 0; --remaining, ++p) {
+      h = std::rotl(h ^ (static_cast<unsigned char>(*p) * prime5), 11) *
+          prime1;
+    }
+
+    h ^= h >> 33U;
+    h *= prime2;
+    h ^= h >> 29U;
+    h *= prime3;
+    h ^= h >> 32U;
+    return h;
+  }
+
+ protected:
+  auto overflow(int_type ch) -> int_type override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    consume_buffer();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+  }
+
+  auto xsputn(const char_type* s, std::streamsize count)
+      -> std::streamsize override {
+    // Empty writes may come with a null `s`, which memcpy does not accept.
+    if (count <= 0) {
+      return 0;
+    }
+    auto n = static_cast<std::size_t>(count);
+    const auto room = static_cast<std::size_t>(epptr() - pptr());
+    if (n < room) {
+      std::memcpy(pptr(), s, n);
+      pbump(static_cast<int>(n));
+      return count;
+    }
+    std::memcpy(pptr(), s, room);
+    pbump(static_cast<int>(room));
+    consume_buffer();
+    s += room;
+    n -= room;
+    // Large writes are hashed in place rather than through the buffer.
+    for (; n >= buffer_size; n -= stripe_size, s += stripe_size) {
+      consume_stripe(acc_, s);
+      consumed_ += stripe_size;
+    }
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return count;
+  }
+
+ private:
+  static constexpr std::size_t stripe_size = 32;
+  static constexpr std::size_t buffer_size = stripe_size * 8;
+  // Every `pbump` advances by at most `buffer_size` bytes.
+  static_assert(buffer_size <= INT_MAX);
+  static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+  static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+  static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+  static auto round(std::uint64_t acc, std::uint64_t input) -> std::uint64_t {
+    return std::rotl(acc + input * prime2, 31) * prime1;
+  }
+
+  template <typename U>
+  static auto read_le(const char* p) -> U {
+    U v = 0;
+    std::memcpy(&v, p, sizeof(U));
+    if constexpr (std::endian::native == std::endian::big) {
+      U r = 0;
+      for (std::size_t i = 0; i < sizeof(U); ++i) {
+        r = static_cast<U>((r << 8U) | (v & 0xFFU));
+        v >>= 8U;
+      }
+      v = r;
+    }
+    return v;
+  }
+
+  static auto read64(const char* p) -> std::uint64_t {
+    return read_le<std::uint64_t>(p);
+  }
+  static auto read32(const char* p) -> std::uint64_t {
+    return read_le<std::uint32_t>(p);
+  }
+
+  auto buffered() const -> std::size_t {
+    return static_cast<std::size_t>(pptr() - pbase());
+  }
+
+  using accumulators = std::array<std::uint64_t, 4>;
+
+  static void consume_stripe(accumulators& acc, const char* p) {
+    for (std::size_t i = 0; i < acc.size(); ++i) {
+      acc[i] = round(acc[i], read64(p + (i * 8)));
+    }
+  }
+
+  // Only called when the buffer is full, so it always empties it.
+  void consume_buffer() {
+    for (std::size_t i = 0; i < buffer_size; i += stripe_size) {
+      consume_stripe(acc_, buffer_ + i);
+    }
+    consumed_ += buffer_size;
+    setp(buffer_, buffer_ + buffer_size);
+  }
+
+  std::uint64_t seed_ = 0;
+  accumulators acc_ = {};
+  std::uint64_t consumed_ = 0;
+  char buffer_[buffer_size] = {};  // NOLINT(*-avoid-c-arrays)
+};
+
+}  // namespace detail
+
+// Output stream that hashes everything written to it with XXH64 instead of
+// storing it. `digest()` equals `fingerprint_text()` of the same bytes.
+class fingerprint_stream : private detail::xxh64_buf, public std::ostream {
+ public:
+  explicit fingerprint_stream(std::uint64_t seed = 0)
+      : detail::xxh64_buf(seed),
+        std::ostream(static_cast<detail::xxh64_buf*>(this)) {}
+
+  fingerprint_stream(const fingerprint_stream&) = delete;
+  fingerprint_stream(fingerprint_stream&&) = delete;
+  auto operator=(const fingerprint_stream&) -> fingerprint_stream& = delete;
+  auto operator=(fingerprint_stream&&) -> fingerprint_stream& = delete;
+  ~fingerprint_stream() override = default;
+
+  using detail::xxh64_buf::digest;
+  using detail::xxh64_buf::length;
+  using detail::xxh64_buf::update;
+
+  void reset(std::uint64_t seed = 0) {
+    detail::xxh64_buf::reset(seed);
+    std::ostream::clear();
+  }
+};
+
+inline auto fingerprint_text(std::string_view text,
+                             std::uint64_t seed = 0) -> std::uint64_t {
+  detail::xxh64_buf h(seed);
+  h.update(text.data(), text.size());
+  return h.digest();
+}
+
+// Same value as `fingerprint_text(to_string(obj), seed)`, without
+// materializing the string.
+template <typename T>
+auto fingerprint(const T& obj, std::uint64_t seed = 0) -> std::uint64_t {
+  fingerprint_stream fs(seed);
+  fs << make_inspectable(obj);
+  return fs.digest();
+}
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_binary_hashable_v =
+    std::is_integral_v<T> || std::is_enum_v<T> || std::is_same_v<T, float> ||
+    std::is_same_v<T, double>;
+
+template <typename T, typename = void>
+constexpr bool has_stream_insertion_v = false;
+
+template <typename T>
+constexpr bool has_stream_insertion_v<
+    T,
+    std::void_t<decltype(std::declval<std::ostream&>()
+                         << std::declval<const T&>())>> = true;
+
+template <typename T>
+constexpr bool is_binary_hashable_range_v = false;
+
+template <typename T>
+  requires std::ranges::contiguous_range<const T> &&
+           std::ranges::sized_range<const T>
+constexpr bool is_binary_hashable_range_v<T> =
+    is_binary_hashable_v<std::ranges::range_value_t<const T>>;
+
+// Ranges that are traversed element by element. A range whose elements are
+// of its own type is excluded, as the traversal would never reach a leaf.
+template <typename T>
+constexpr bool is_traversable_range_v = false;
+
+template <typename T>
+  requires std::ranges::input_range<const T>
+constexpr bool is_traversable_range_v<T> =
+    !std::same_as<std::ranges::range_value_t<const T>, T>;
+
+// The text length is appended so neighbouring values cannot run together.
+template <typename T>
+void text_fingerprint_impl(fingerprint_stream& fs, const T& obj) {
+  const auto before = fs.length();
+  fs << make_inspectable(obj);
+  const auto written = fs.length() - before;
+  fs.update(&written, sizeof(written));
+}
+
+template <typename T>
+void binary_fingerprint_impl(fingerprint_stream& fs, const T& obj) {
+  if constexpr (has_inspect_member<T> || has_adl_inspect<T>) {
+    text_fingerprint_impl(fs, obj);
+  } else if constexpr (is_binary_hashable_v<T>) {
+    fs.update(&obj, sizeof(obj));
+  } else if constexpr (is_binary_hashable_range_v<T>) {
+    // Numeric payloads are hashed as one block of memory.
+    const auto size = static_cast<std::uint64_t>(std::ranges::size(obj));
+    fs.update(&size, sizeof(size));
+    fs.update(std::ranges::data(obj),
+              size * sizeof(std::ranges::range_value_t<T>));
+  } else if constexpr (has_stream_insertion_v<T>) {
+    // The type prints itself, e.g. `std::filesystem::path`, whose elements
+    // are paths again; walking it element-wise would never terminate.
+    text_fingerprint_impl(fs, obj);
+  } else if constexpr (is_traversable_range_v<T>) {
+    std::uint64_t count = 0;
+    for (const auto& elem : obj) {
+      binary_fingerprint_impl(fs, elem);
+      ++count;
+    }
+    fs.update(&count, sizeof(count));
+  } else if constexpr (is_optional_v<T>) {
+    const bool engaged = obj.has_value();
+    fs.update(&engaged, sizeof(engaged));
+    if (engaged) {
+      binary_fingerprint_impl(fs, *obj);
+    }
+  } else if constexpr (is_tuple_like_v<T>) {
+    std::apply(
+        [&fs](const auto&... elems) {
+          (binary_fingerprint_impl(fs, elems), ...);
+        },
+        obj);
+  } else {
+    text_fingerprint_impl(fs, obj);
+  }
+}
+
+}  // namespace detail
+
+// Hashes the in-memory representation of numbers instead of their text,
+// which is much faster for numeric-heavy containers. Ranges, tuples and
+// optionals are traversed structurally; anything else, including ranges with
+// their own `inspect` or `operator<<`, is hashed through its inspector. The
+// value differs from `fingerprint()` and depends on the platform's integer
+// widths, endianness and floating-point layout.
+template <typename T>
+auto binary_fingerprint(const T& obj, std::uint64_t seed = 0)
+    -> std::uint64_t {
+  fingerprint_stream fs(seed);
+  detail::binary_fingerprint_impl(fs, obj);
+  return fs.digest();
+}
+
+}  // namespace insp
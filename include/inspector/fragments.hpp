@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+#  include <sys/uio.h>
+#endif
+
+#include "buffer.hpp"
+#include "core.hpp"
+
+namespace insp {
+
+struct fragment {
+  const char* data;
+  std::size_t size;
+};
+
+namespace detail {
+
+// Collects output as a list of fragments: small writes are appended to an
+// owned buffer, while string leaves of at least `min_reference_size` bytes
+// are recorded as pointers to the caller's data.
+class fragment_buf : public container_buf<std::vector<char>>,
+                     public string_leaf_sink {
+ public:
+  explicit fragment_buf(std::size_t min_reference_size)
+      : min_reference_size_(min_reference_size) {}
+
+  auto fragments() -> const std::vector<fragment>& {
+    close_owned_run();
+    fragments_.clear();
+    fragments_.reserve(entries_.size());
+    for (const auto& e : entries_) {
+      fragments_.push_back(
+          {e.ref != nullptr ? e.ref : data() + e.offset, e.size});
+    }
+    return fragments_;
+  }
+
+  void reset() {
+    container_buf::reset();
+    entries_.clear();
+    fragments_.clear();
+    run_begin_ = 0;
+  }
+
+  auto put_reference(const std::streambuf* buf,
+                     std::string_view str) -> bool override {
+    if (buf != this || str.size() < min_reference_size_) {
+      return false;
+    }
+    close_owned_run();
+    entries_.push_back({str.data(), 0, str.size()});
+    return true;
+  }
+
+ private:
+  // Owned runs are stored as offsets because the buffer moves as it grows.
+  struct entry {
+    const char* ref;  // nullptr for a run of the owned buffer
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  void close_owned_run() {
+    const auto end = size();
+    if (end > run_begin_) {
+      entries_.push_back({nullptr, run_begin_, end - run_begin_});
+      run_begin_ = end;
+    }
+  }
+
+  std::size_t min_reference_size_;
+  std::vector<entry> entries_;
+  std::vector<fragment> fragments_;
+  std::size_t run_begin_ = 0;
+};
+
+}  // namespace detail
+
+// Output stream that produces a scatter-gather list instead of a flat string.
+// Formatting punctuation and numbers are copied into an owned buffer, while
+// `std::string`/`std::string_view` leaves of at least `min_reference_size`
+// bytes are referenced in place, so they must outlive the fragments.
+// Leaves inserted with a non-zero `width` are padded and copied instead.
+class fragment_stream : private detail::fragment_buf, public std::ostream {
+ public:
+  static constexpr std::size_t default_min_reference_size = 64;
+
+  explicit fragment_stream(
+      std::size_t min_reference_size = default_min_reference_size)
+      : detail::fragment_buf(min_reference_size),
+        std::ostream(static_cast<detail::fragment_buf*>(this)) {
+    pword(detail::string_leaf_sink_index()) =
+        static_cast<detail::string_leaf_sink*>(this);
+  }
+
+  fragment_stream(const fragment_stream&) = delete;
+  fragment_stream(fragment_stream&&) = delete;
+  auto operator=(const fragment_stream&) -> fragment_stream& = delete;
+  auto operator=(fragment_stream&&) -> fragment_stream& = delete;
+  ~fragment_stream() override = default;
+
+  // The returned pointers stay valid until the next write or `reset()`.
+  using detail::fragment_buf::fragments;
+
+  // Drops all fragments and clears the stream state for reuse.
+  void reset() {
+    detail::fragment_buf::reset();
+    std::ostream::clear();
+  }
+
+#if __has_include(<sys/uio.h>)
+  // Fragments in the layout expected by `writev`/`sendmsg`.
+  auto iovecs() -> std::vector<::iovec> {
+    const auto& frags = fragments();
+    std::vector<::iovec> iov;
+    iov.reserve(frags.size());
+    for (const auto& f : frags) {
+      // iovec is shared by reads and writes, hence the non-const base.
+      iov.push_back({const_cast<char*>(f.data), f.size});  // NOLINT
+    }
+    return iov;
+  }
+#endif
+};
+
+}  // namespace insp
@@ -3,9 +3,17 @@
 // clang-format off
 // IWYU pragma: begin_exports
 #include "inspector/core.hpp"
+#include "inspector/any.hpp"
+#include "inspector/batch.hpp"
+#include "inspector/bytes.hpp"
 #include "inspector/chrono.hpp"
 #include "inspector/containers.hpp"
+#include "inspector/fingerprint.hpp"
+#include "inspector/fragments.hpp"
+#include "inspector/iterative.hpp"
 #include "inspector/optional.hpp"
+#include "inspector/style.hpp"
+#include "inspector/type_name.hpp"
 #include "inspector/utility.hpp"
 // IWYU pragma: end_exports
 // clang-format on
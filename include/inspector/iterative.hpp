@@ -0,0 +1,485 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "containers.hpp"
+#include "core.hpp"
+#include "optional.hpp"
+#include "utility.hpp"
+
+namespace insp {
+namespace detail {
+
+inline constexpr std::size_t frame_state_size = 48;
+
+class traversal;
+
+// One open level of the traversal. `step` is resumed each time the frame is
+// on top of the stack and emits at most one child; it returns false once the
+// frame has closed. `state` holds the frame's iterator or view in place,
+// or a pointer to an iterator too large for it.
+struct frame {
+  using step_fn = auto (*)(traversal& t, frame& f) -> bool;
+  using destroy_fn = void (*)(frame& f);
+
+  step_fn step;
+  destroy_fn destroy;
+  const void* obj;
+  std::size_t index;
+  std::size_t depth;
+  alignas(std::max_align_t) std::byte state[frame_state_size];  // NOLINT
+
+  template <typename S>
+  auto get() -> S& {
+    return *std::launder(reinterpret_cast<S*>(state));  // NOLINT
+  }
+};
+
+template <typename S>
+constexpr bool fits_frame_v = sizeof(S) <= frame_state_size &&
+                              alignof(S) <= alignof(std::max_align_t);
+
+// Stack of frames allocated in fixed-size blocks. Frames never move, so a
+// step function may push children while holding a reference to its own
+// frame, and blocks are kept for reuse once allocated.
+class frame_stack {
+ public:
+  static constexpr std::size_t block_size = 64;
+
+  frame_stack() = default;
+  frame_stack(const frame_stack&) = delete;
+  frame_stack(frame_stack&&) = delete;
+  auto operator=(const frame_stack&) -> frame_stack& = delete;
+  auto operator=(frame_stack&&) -> frame_stack& = delete;
+  ~frame_stack() { clear(); }
+
+  void reserve(std::size_t frames) {
+    while (blocks_.size() * block_size < frames) {
+      blocks_.push_back(std::make_unique<frame[]>(block_size));  // NOLINT
+    }
+  }
+
+  auto push() -> frame& {
+    reserve(size_ + 1);
+    auto& f = blocks_[size_ / block_size][size_ % block_size];
+    ++size_;
+    return f;
+  }
+
+  auto top() -> frame& {
+    return blocks_[(size_ - 1) / block_size][(size_ - 1) % block_size];
+  }
+
+  void pop() {
+    auto& f = top();
+    if (f.destroy != nullptr) {
+      f.destroy(f);
+    }
+    --size_;
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop();
+    }
+  }
+
+  auto empty() const -> bool { return size_ == 0; }
+  auto size() const -> std::size_t { return size_; }
+
+ private:
+  std::vector<std::unique_ptr<frame[]>> blocks_;  // NOLINT(*-avoid-c-arrays)
+  std::size_t size_ = 0;
+};
+
+// Containers whose built-in inspectors print `[a, b]` or `{k: v}`.
+template <typename T>
+constexpr bool is_traversable_sequence_v = false;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::vector<T>> = true;
+
+template <typename T, std::size_t N>
+constexpr bool is_traversable_sequence_v<std::array<T, N>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::deque<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::forward_list<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::list<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::set<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::unordered_set<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::multiset<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_sequence_v<std::unordered_multiset<T>> = true;
+
+template <typename T>
+constexpr bool is_traversable_map_v = false;
+
+template <typename K, typename V>
+constexpr bool is_traversable_map_v<std::map<K, V>> = true;
+
+template <typename K, typename V>
+constexpr bool is_traversable_map_v<std::unordered_map<K, V>> = true;
+
+template <typename K, typename V>
+constexpr bool is_traversable_map_v<std::multimap<K, V>> = true;
+
+template <typename K, typename V>
+constexpr bool is_traversable_map_v<std::unordered_multimap<K, V>> = true;
+
+template <typename T>
+constexpr bool is_traversable_tuple_v = false;
+
+template <typename T1, typename T2>
+constexpr bool is_traversable_tuple_v<std::pair<T1, T2>> = true;
+
+template <typename... Args>
+constexpr bool is_traversable_tuple_v<std::tuple<Args...>> = true;
+
+// Tuples written by the built-in inspectors rather than a user override.
+template <typename T>
+constexpr bool is_traversed_tuple_v =
+    is_traversable_tuple_v<T> && !has_inspect_member<T> &&
+    !has_adl_inspect<T> && !has_adl_inspect_as<T>;
+
+class traversal {
+ public:
+  explicit traversal(std::size_t max_depth) : max_depth_(max_depth) {}
+
+  template <typename Style, typename T>
+  auto run(std::ostream& os, const T& obj) -> std::ostream& {
+    os_ = &os;
+    const indent_guard<Style> guard(os);
+    try {
+      visit<Style>(obj);
+      while (!stack_.empty()) {
+        auto& f = stack_.top();
+        if (!f.step(*this, f)) {
+          stack_.pop();
+        }
+      }
+    } catch (...) {
+      stack_.clear();
+      throw;
+    }
+    return os;
+  }
+
+  void reserve(std::size_t frames) { stack_.reserve(frames); }
+
+ private:
+  auto depth() -> std::size_t {
+    return stack_.empty() ? 0 : stack_.top().depth;
+  }
+
+  // Opens a bracketed level, or prints "..." when it would be too deep.
+  // Containers are `block`s that a pretty style breaks into lines.
+  template <typename Style>
+  auto open(const void* obj,
+            frame::step_fn step,
+            char bracket,
+            bool block,
+            bool empty) -> frame* {
+    const auto d = depth() + 1;
+    if (d > max_depth_) {
+      *os_ << "...";
+      return nullptr;
+    }
+    if (block) {
+      write_open<Style>(*os_, bracket, empty);
+    } else {
+      *os_ << bracket;
+    }
+    auto& f = stack_.push();
+    f.step = step;
+    f.destroy = nullptr;
+    f.obj = obj;
+    f.index = 0;
+    f.depth = d;
+    return &f;
+  }
+
+  // Emits `obj`, pushing at most one frame. Types are resolved in the same
+  // order as `make_inspectable`; anything without a built-in structure is
+  // written through its inspector as a leaf.
+  template <typename Style, typename T>
+  void visit(const T& obj) {
+    if constexpr (has_inspect_member<T> || has_adl_inspect<T>) {
+      *os_ << make_inspectable<Style>(obj);
+    } else if constexpr (has_adl_inspect_as<T>) {
+      visit_view<Style>(obj);
+    } else if constexpr (is_optional_v<T>) {
+      if (obj) {
+        visit<Style>(*obj);
+      } else {
+        *os_ << "nullopt";
+      }
+    } else if constexpr (is_traversable_map_v<T>) {
+      open_range<Style>(obj, &step_map<Style, T>, '{');
+    } else if constexpr (is_traversable_sequence_v<T> && !is_byte_range_v<T>) {
+      open_range<Style>(obj, &step_sequence<Style, T>, '[');
+    } else if constexpr (is_traversable_tuple_v<T>) {
+      open<Style>(&obj, &step_tuple<Style, T>, '(', false, false);
+    } else {
+      *os_ << make_inspectable<Style>(obj);
+    }
+  }
+
+  // The iterator lives in the frame, or on the heap when it is too large
+  // for it, as the checked iterators of some debug builds are.
+  template <typename Style, typename C>
+  void open_range(const C& obj, frame::step_fn step, char bracket) {
+    using iterator = decltype(std::begin(obj));
+    const bool empty = std::begin(obj) == std::end(obj);
+    auto* f = open<Style>(&obj, step, bracket, true, empty);
+    if (f == nullptr) {
+      return;
+    }
+    if constexpr (fits_frame_v<iterator>) {
+      ::new (static_cast<void*>(f->state)) iterator(std::begin(obj));
+      if constexpr (!std::is_trivially_destructible_v<iterator>) {
+        f->destroy = &destroy_iterator<iterator>;
+      }
+    } else {
+      auto* it = new iterator(std::begin(obj));
+      ::new (static_cast<void*>(f->state)) iterator*(it);
+      f->destroy = &destroy_iterator<iterator>;
+    }
+  }
+
+  template <typename Style, typename T>
+  void visit_view(const T& obj) {
+    using view = decltype(inspect_as(obj));
+    if constexpr (std::is_reference_v<view>) {
+      visit<Style>(inspect_as(obj));
+    } else if constexpr (is_traversed_tuple_v<view> && fits_frame_v<view>) {
+      // The common `std::tie` case: the tuple lives in its own frame.
+      if (auto* f = open<Style>(nullptr, &step_tuple<Style, view>, '(', false,
+                                false)) {
+        f->obj = ::new (static_cast<void*>(f->state)) view(inspect_as(obj));
+        if constexpr (!std::is_trivially_destructible_v<view>) {
+          f->destroy = &destroy_view<view>;
+        }
+      }
+    } else if constexpr (fits_frame_v<view>) {
+      // The view is a temporary, so it is kept alive in a frame of its own
+      // that adds no brackets and no depth.
+      const auto d = depth();
+      auto& f = stack_.push();
+      f.step = &step_view<Style, view>;
+      f.destroy = nullptr;
+      f.obj = &obj;
+      f.index = 0;
+      f.depth = d;
+      // Only a constructed view may be destroyed if `inspect_as` throws.
+      ::new (static_cast<void*>(f.state)) view(inspect_as(obj));
+      if constexpr (!std::is_trivially_destructible_v<view>) {
+        f.destroy = &destroy_view<view>;
+      }
+    } else {
+      *os_ << make_inspectable<Style>(obj);
+    }
+  }
+
+  template <typename Style, typename C>
+  static auto step_sequence(traversal& t, frame& f) -> bool {
+    using iterator = decltype(std::begin(std::declval<const C&>()));
+    const auto& obj = *static_cast<const C*>(f.obj);
+    auto& it = iterator_of<iterator>(f);
+    if (it == std::end(obj)) {
+      write_close<Style>(*t.os_, ']', f.index == 0);
+      return false;
+    }
+    if (f.index++ != 0) {
+      write_separator<Style>(*t.os_);
+    }
+    const auto& elem = *it++;
+    t.visit<Style>(elem);
+    return true;
+  }
+
+  // Even steps emit a key, odd steps its value.
+  template <typename Style, typename M>
+  static auto step_map(traversal& t, frame& f) -> bool {
+    using iterator = decltype(std::begin(std::declval<const M&>()));
+    const auto& obj = *static_cast<const M*>(f.obj);
+    auto& it = iterator_of<iterator>(f);
+    if (f.index % 2 == 0) {
+      if (it == std::end(obj)) {
+        write_close<Style>(*t.os_, '}', f.index == 0);
+        return false;
+      }
+      if (f.index != 0) {
+        write_separator<Style>(*t.os_);
+      }
+      ++f.index;
+      t.visit<Style>(it->first);
+    } else {
+      *t.os_ << Style::key_separator;
+      ++f.index;
+      t.visit<Style>((it++)->second);
+    }
+    return true;
+  }
+
+  template <typename Style, typename Tuple, std::size_t... I>
+  static void visit_element(traversal& t,
+                            const Tuple& obj,
+                            std::size_t index,
+                            std::index_sequence<I...> /*unused*/) {
+    using visit_fn = void (*)(traversal&, const Tuple&);
+    static constexpr std::array<visit_fn, sizeof...(I)> table = {
+        [](traversal& self, const Tuple& tuple) {
+          self.visit<Style>(std::get<I>(tuple));
+        }...};
+    table[index](t, obj);
+  }
+
+  template <typename Style, typename Tuple>
+  static auto step_tuple(traversal& t, frame& f) -> bool {
+    constexpr auto size = std::tuple_size_v<Tuple>;
+    if (f.index == size) {
+      *t.os_ << ')';
+      return false;
+    }
+    if constexpr (size > 0) {
+      if (f.index != 0) {
+        *t.os_ << Style::separator;
+      }
+      visit_element<Style>(t, *static_cast<const Tuple*>(f.obj), f.index++,
+                           std::make_index_sequence<size>{});
+    }
+    return true;
+  }
+
+  template <typename Style, typename View>
+  static auto step_view(traversal& t, frame& f) -> bool {
+    if (f.index++ != 0) {
+      return false;
+    }
+    t.visit<Style>(f.get<View>());
+    return true;
+  }
+
+  template <typename View>
+  static void destroy_view(frame& f) {
+    std::destroy_at(&f.get<View>());
+  }
+
+  template <typename Iterator>
+  static auto iterator_of(frame& f) -> Iterator& {
+    if constexpr (fits_frame_v<Iterator>) {
+      return f.get<Iterator>();
+    } else {
+      return *f.get<Iterator*>();
+    }
+  }
+
+  template <typename Iterator>
+  static void destroy_iterator(frame& f) {
+    if constexpr (fits_frame_v<Iterator>) {
+      std::destroy_at(&f.get<Iterator>());
+    } else {
+      delete f.get<Iterator*>();
+    }
+  }
+
+  std::ostream* os_ = nullptr;
+  frame_stack stack_;
+  std::size_t max_depth_;
+};
+
+}  // namespace detail
+
+// Inspects nested standard containers, pairs, tuples and optionals with an
+// explicit work stack instead of recursion, so the native stack use does not
+// grow with the depth of the data. User types are written through their own
+// `inspect` as leaves unless they provide an ADL `inspect_as`, which is
+// traversed like the object it returns. Output is identical to
+// `make_inspectable` in every style, except that containers nested deeper
+// than `max_depth` are shown as `...`. Specializations of `inspector` for
+// the traversed standard types are not consulted.
+//
+// The work stack is kept between calls, so reusing one instance avoids
+// reallocating it.
+class iterative_inspector {
+ public:
+  static constexpr std::size_t unlimited =
+      std::numeric_limits<std::size_t>::max();
+
+  explicit iterative_inspector(std::size_t max_depth = unlimited)
+      : traversal_(max_depth) {}
+
+  iterative_inspector(const iterative_inspector&) = delete;
+  iterative_inspector(iterative_inspector&&) = delete;
+  auto operator=(const iterative_inspector&) -> iterative_inspector& = delete;
+  auto operator=(iterative_inspector&&) -> iterative_inspector& = delete;
+  ~iterative_inspector() = default;
+
+  template <typename Style = default_style, typename T>
+  auto inspect(std::ostream& os, const T& obj) -> std::ostream& {
+    return traversal_.run<Style>(os, obj);
+  }
+
+  // Preallocates room for `depth` levels of nesting.
+  void reserve(std::size_t depth) { traversal_.reserve(depth); }
+
+ private:
+  detail::traversal traversal_;
+};
+
+namespace detail {
+
+template <typename T>
+struct iterative_wrapper {
+  const T* obj;
+  std::size_t max_depth;
+
+  template <typename Style = default_style>
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    iterative_inspector engine(max_depth);
+    return engine.inspect<Style>(os, *obj);
+  }
+};
+
+}  // namespace detail
+
+// Inspects `obj` with a temporary `iterative_inspector`, e.g.
+// `insp::to_string(insp::iterative(tree, 64))`.
+template <typename T>
+auto iterative(const T& obj,
+               std::size_t max_depth = iterative_inspector::unlimited)
+    -> detail::iterative_wrapper<T> {
+  return detail::iterative_wrapper<T>{&obj, max_depth};
+}
+
+}  // namespace insp
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "buffer.hpp"
+
+namespace insp {
+namespace detail {
+
+[[noreturn]] inline void throw_errno(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Creates `path` for reading and writing. Returns -1 with `errno` set, and
+// fails with EEXIST rather than truncating a file that is already there.
+inline auto create_file(const std::string& path) noexcept -> int {
+  return ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+}
+
+// One pre-extended, memory-mapped file. Writers carve disjoint regions out of
+// it by advancing `offset_`; the file is truncated to the used size once the
+// last region referencing it is released.
+class mmap_segment {
+ public:
+  // Takes ownership of `fd`, an empty file opened for reading and writing.
+  mmap_segment(int fd, std::size_t capacity) : fd_(fd), capacity_(capacity) {
+    if (::ftruncate(fd_, static_cast<off_t>(capacity_)) != 0) {
+      close_and_throw(errno, "ftruncate");
+    }
+#if defined(__linux__)
+    // Allocate the blocks up front so a full disk surfaces here instead of
+    // as SIGBUS on a store into the mapping.
+    if (int err = ::posix_fallocate(fd_, 0, static_cast<off_t>(capacity_));
+        err != 0) {
+      close_and_throw(err, "posix_fallocate");
+    }
+#endif
+    void* addr = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd_, 0);
+    if (addr == MAP_FAILED) {
+      close_and_throw(errno, "mmap");
+    }
+    base_ = static_cast<char*>(addr);
+  }
+
+  mmap_segment(const mmap_segment&) = delete;
+  mmap_segment(mmap_segment&&) = delete;
+  auto operator=(const mmap_segment&) -> mmap_segment& = delete;
+  auto operator=(mmap_segment&&) -> mmap_segment& = delete;
+
+  ~mmap_segment() {
+    ::munmap(base_, capacity_);
+    [[maybe_unused]] int ret =
+        ::ftruncate(fd_, static_cast<off_t>(offset_.load()));
+    close_noexcept();
+  }
+
+  // Returns the start of a fresh `size`-byte region, or nullptr when the
+  // segment cannot hold it.
+  auto try_reserve(std::size_t size) noexcept -> char* {
+    auto offset = offset_.load(std::memory_order_relaxed);
+    do {
+      if (size > capacity_ - offset) {
+        return nullptr;
+      }
+    } while (!offset_.compare_exchange_weak(offset, offset + size,
+                                            std::memory_order_relaxed));
+    return base_ + offset;
+  }
+
+  // Grows the reservation ending at `last` by `size` bytes if it is still the
+  // most recent one.
+  auto try_extend(const char* last, std::size_t size) noexcept -> bool {
+    auto expected = static_cast<std::size_t>(last - base_);
+    return size <= capacity_ - expected &&
+           offset_.compare_exchange_strong(expected, expected + size,
+                                           std::memory_order_relaxed);
+  }
+
+  // Gives back [first, last) if it is still the most recent reservation, so
+  // an idle writer does not leave a hole at the end of the file.
+  void release(const char* first, const char* last) noexcept {
+    auto expected = static_cast<std::size_t>(last - base_);
+    offset_.compare_exchange_strong(expected,
+                                    static_cast<std::size_t>(first - base_),
+                                    std::memory_order_relaxed);
+  }
+
+  auto capacity() const noexcept -> std::size_t { return capacity_; }
+  auto size() const noexcept -> std::size_t { return offset_.load(); }
+
+ private:
+  void close_noexcept() noexcept {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  // `err` is taken before closing, as `close` may overwrite `errno`.
+  [[noreturn]] void close_and_throw(int err, const char* what) {
+    close_noexcept();
+    throw std::system_error(err, std::generic_category(), what);
+  }
+
+  int fd_ = -1;
+  char* base_ = nullptr;
+  std::size_t capacity_;
+  std::atomic<std::size_t> offset_{0};
+};
+
+}  // namespace detail
+
+struct mmap_sink_options {
+  // Size every file is pre-extended to before it is mapped.
+  std::size_t file_size = std::size_t{64} << 20U;
+  // Granularity at which writers reserve space from the current file.
+  std::size_t chunk_size = std::size_t{64} << 10U;
+};
+
+// A sequence of memory-mapped files `<path>.0`, `<path>.1`, ... shared by any
+// number of `mmap_writer`s. A new file is started when the current one cannot
+// hold the next reservation.
+//
+// Existing files are never overwritten. A suffix whose file already exists,
+// for example from an earlier run or another sink on the same path, is
+// skipped and numbering continues with the next one; `file_path()` reports
+// the files this sink actually created.
+//
+// Writers reserve whole chunks, so with several concurrent writers a file may
+// contain zero-filled gaps where a chunk was abandoned early. Records
+// themselves are always contiguous.
+class mmap_sink {
+ public:
+  struct region {
+    std::shared_ptr<detail::mmap_segment> segment;
+    char* data = nullptr;
+    std::size_t size = 0;
+  };
+
+  explicit mmap_sink(std::string path, mmap_sink_options options = {})
+      : path_(std::move(path)), options_(options) {
+    current_ = open_segment(options_.file_size);
+  }
+
+  auto reserve(std::size_t size) -> region {
+    for (;;) {
+      auto segment = current();
+      if (char* data = segment->try_reserve(size)) {
+        return {std::move(segment), data, size};
+      }
+      roll_over(segment, size);
+    }
+  }
+
+  auto options() const noexcept -> const mmap_sink_options& {
+    return options_;
+  }
+
+  // Number of files created so far.
+  auto file_count() const -> std::size_t {
+    const std::lock_guard lock(mutex_);
+    return files_.size();
+  }
+
+  // Path of the `index`-th file created by this sink.
+  auto file_path(std::size_t index) const -> std::string {
+    const std::lock_guard lock(mutex_);
+    return files_.at(index);
+  }
+
+ private:
+  auto current() const -> std::shared_ptr<detail::mmap_segment> {
+    const std::lock_guard lock(mutex_);
+    return current_;
+  }
+
+  void roll_over(const std::shared_ptr<detail::mmap_segment>& full,
+                 std::size_t size) {
+    const std::lock_guard lock(mutex_);
+    if (current_ == full) {
+      current_ = open_segment(std::max(options_.file_size, size));
+    }
+  }
+
+  auto open_segment(std::size_t capacity)
+      -> std::shared_ptr<detail::mmap_segment> {
+    for (;;) {
+      auto path = path_ + '.' + std::to_string(next_suffix_++);
+      const int fd = detail::create_file(path);
+      if (fd < 0) {
+        if (errno == EEXIST) {
+          continue;
+        }
+        detail::throw_errno("open");
+      }
+      auto segment = std::make_shared<detail::mmap_segment>(fd, capacity);
+      files_.push_back(std::move(path));
+      return segment;
+    }
+  }
+
+  std::string path_;
+  mmap_sink_options options_;
+  mutable std::mutex mutex_;
+  std::size_t next_suffix_ = 0;
+  std::vector<std::string> files_;
+  std::shared_ptr<detail::mmap_segment> current_;
+};
+
+namespace detail {
+
+class mmap_writer_buf : public put_area_buf {
+ public:
+  explicit mmap_writer_buf(mmap_sink& sink) : sink_(&sink) {}
+
+  mmap_writer_buf(const mmap_writer_buf&) = delete;
+  mmap_writer_buf(mmap_writer_buf&&) = delete;
+  auto operator=(const mmap_writer_buf&) -> mmap_writer_buf& = delete;
+  auto operator=(mmap_writer_buf&&) -> mmap_writer_buf& = delete;
+
+  ~mmap_writer_buf() override { release(); }
+
+  void commit() noexcept { record_ = pptr(); }
+
+  // Commits the current record and hands the unused part of the chunk back.
+  void release() noexcept {
+    commit();
+    if (region_.segment) {
+      region_.segment->release(pptr(), epptr());
+      region_ = {};
+      record_ = nullptr;
+      setp(nullptr, nullptr);
+    }
+  }
+
+ protected:
+  auto overflow(int_type ch) -> int_type override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    grow(1);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+  }
+
+  auto xsputn(const char_type* s, std::streamsize count)
+      -> std::streamsize override {
+    auto n = static_cast<std::size_t>(count);
+    if (n > static_cast<std::size_t>(epptr() - pptr())) {
+      grow(n);
+    }
+    traits_type::copy(pptr(), s, n);
+    advance_put(n);
+    return count;
+  }
+
+ private:
+  // Makes room for `extra` more bytes. The region is extended in place when
+  // no other writer reserved after it; otherwise the pending record moves to
+  // a new region, so records never straddle two regions.
+  void grow(std::size_t extra) {
+    const auto pending = static_cast<std::size_t>(pptr() - record_);
+    const auto size = std::max(sink_->options().chunk_size, pending + extra);
+    if (region_.segment && region_.segment->try_extend(epptr(), size)) {
+      region_.size += size;
+      setp_at(region_.data, pptr(), region_.data + region_.size);
+      return;
+    }
+    auto next = sink_->reserve(size);
+    if (pending > 0) {
+      traits_type::copy(next.data, record_, pending);
+      // The abandoned copy must not show up as a duplicate partial record.
+      traits_type::assign(record_, pending, char_type{});
+    }
+    if (region_.segment) {
+      region_.segment->release(record_, epptr());
+    }
+    region_ = std::move(next);
+    record_ = region_.data;
+    setp_at(region_.data, region_.data + pending,
+            region_.data + region_.size);
+  }
+
+  mmap_sink* sink_;
+  mmap_sink::region region_;
+  char* record_ = nullptr;
+};
+
+}  // namespace detail
+
+// Per-thread output stream into an `mmap_sink`. Everything written between
+// two `commit()` calls lands in one contiguous region of one file.
+class mmap_writer : private detail::mmap_writer_buf, public std::ostream {
+ public:
+  explicit mmap_writer(mmap_sink& sink)
+      : detail::mmap_writer_buf(sink),
+        std::ostream(static_cast<detail::mmap_writer_buf*>(this)) {}
+
+  mmap_writer(const mmap_writer&) = delete;
+  mmap_writer(mmap_writer&&) = delete;
+  auto operator=(const mmap_writer&) -> mmap_writer& = delete;
+  auto operator=(mmap_writer&&) -> mmap_writer& = delete;
+  ~mmap_writer() override = default;
+
+  using detail::mmap_writer_buf::commit;
+  using detail::mmap_writer_buf::release;
+};
+
+}  // namespace insp
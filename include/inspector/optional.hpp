@@ -6,13 +6,23 @@
 #include "core.hpp"
 
 namespace insp {
+namespace detail {
+
+template <typename T>
+constexpr bool is_optional_v = false;
+
+template <typename T>
+constexpr bool is_optional_v<std::optional<T>> = true;
+
+}  // namespace detail
 
 template <typename T>
 struct inspector<std::optional<T>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::optional<T>& obj) -> std::ostream& {
     if (obj) {
-      return os << make_inspectable(*obj);
+      return os << make_inspectable<Style>(*obj);
     }
     return os << "nullopt";
   }
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace insp {
+
+// Styles are compile-time policies selecting the punctuation of the
+// built-in inspectors: `separator` goes between elements, `key_separator`
+// between a map key and its value. A non-zero `indent_width` puts every
+// element of a container on its own line, after the separator with its
+// trailing whitespace removed; pairs and tuples stay on one line.
+struct default_style {
+  static constexpr std::string_view separator = ", ";
+  static constexpr std::string_view key_separator = ": ";
+  static constexpr std::size_t indent_width = 0;
+};
+
+struct compact_style {
+  static constexpr std::string_view separator = ",";
+  static constexpr std::string_view key_separator = ":";
+  static constexpr std::size_t indent_width = 0;
+};
+
+struct pretty_style {
+  static constexpr std::string_view separator = ", ";
+  static constexpr std::string_view key_separator = ": ";
+  static constexpr std::size_t indent_width = 2;
+};
+
+// Whether `T` has the members of a style.
+template <typename T, typename = void>
+constexpr bool is_style_v = false;
+
+template <typename T>
+constexpr bool is_style_v<
+    T,
+    std::void_t<decltype(std::string_view(T::separator)),
+                decltype(std::string_view(T::key_separator)),
+                decltype(static_cast<std::size_t>(T::indent_width))>> = true;
+
+namespace detail {
+
+// Current indentation level of a pretty-printed stream, kept in an iword so
+// it carries across inspectors.
+inline auto indent_level_index() -> int {
+  static const int index = std::ios_base::xalloc();
+  return index;
+}
+
+template <typename Style>
+void write_newline(std::ostream& os) {
+  constexpr std::string_view spaces = "                                ";
+  os.put('\n');
+  auto n = static_cast<std::size_t>(os.iword(indent_level_index())) *
+           Style::indent_width;
+  while (n > 0) {
+    const auto chunk = std::min(n, spaces.size());
+    os.write(spaces.data(), static_cast<std::streamsize>(chunk));
+    n -= chunk;
+  }
+}
+
+// Restores the indentation level of a pretty-printed stream on scope exit,
+// so that an inspector throwing halfway through a container does not leave
+// the stream indented.
+template <typename Style>
+class indent_guard {
+ public:
+  explicit indent_guard(std::ostream& os) : os_(&os) {
+    if constexpr (Style::indent_width > 0) {
+      level_ = os.iword(indent_level_index());
+    }
+  }
+
+  indent_guard(const indent_guard&) = delete;
+  indent_guard(indent_guard&&) = delete;
+  auto operator=(const indent_guard&) -> indent_guard& = delete;
+  auto operator=(indent_guard&&) -> indent_guard& = delete;
+
+  ~indent_guard() {
+    if constexpr (Style::indent_width > 0) {
+      os_->iword(indent_level_index()) = level_;
+    }
+  }
+
+ private:
+  std::ostream* os_;
+  long level_ = 0;
+};
+
+// Container punctuation. `empty` containers are written as a bare pair of
+// brackets in every style.
+template <typename Style>
+void write_open(std::ostream& os, char bracket, bool empty) {
+  os << bracket;
+  if constexpr (Style::indent_width > 0) {
+    if (!empty) {
+      ++os.iword(indent_level_index());
+      write_newline<Style>(os);
+    }
+  }
+}
+
+// `Style::separator` without trailing whitespace, ending a line.
+template <typename Style>
+constexpr std::string_view line_separator = [] {
+  const std::string_view sep = Style::separator;
+  const auto last = sep.find_last_not_of(" \t");
+  return last == std::string_view::npos ? std::string_view()
+                                        : sep.substr(0, last + 1);
+}();
+
+template <typename Style>
+void write_separator(std::ostream& os) {
+  if constexpr (Style::indent_width > 0) {
+    os << line_separator<Style>;
+    write_newline<Style>(os);
+  } else {
+    os << Style::separator;
+  }
+}
+
+template <typename Style>
+void write_close(std::ostream& os, char bracket, bool empty) {
+  if constexpr (Style::indent_width > 0) {
+    if (!empty) {
+      --os.iword(indent_level_index());
+      write_newline<Style>(os);
+    }
+  }
+  os << bracket;
+}
+
+}  // namespace detail
+}  // namespace insp
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <ranges>
+#include <set>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "containers.hpp"
+#include "core.hpp"
+
+namespace insp {
+
+// GCC leaves types out of the function's own namespace unqualified in
+// `__PRETTY_FUNCTION__`, so `signature()` lives in a namespace that declares
+// no other types.
+namespace signature_probe {
+
+template <typename T>
+constexpr auto signature() -> std::string_view {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+}  // namespace signature_probe
+
+namespace detail {
+
+using signature_probe::signature;
+
+// The signature of `signature<void>()` tells how much decoration surrounds
+// the type name on this compiler.
+constexpr std::size_t signature_prefix = signature<void>().find("void");
+constexpr std::size_t signature_suffix = signature<void>().size() -
+                                         signature_prefix -
+                                         std::string_view("void").size();
+
+template <typename T>
+constexpr auto raw_type_name() -> std::string_view {
+  constexpr auto sig = signature<T>();
+  return sig.substr(signature_prefix,
+                    sig.size() - signature_prefix - signature_suffix);
+}
+
+constexpr auto is_identifier_char(char c) -> bool {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// Copies `name` to `out` without the elaborated type specifiers MSVC puts in
+// front of every class and enum (`struct ns::record`, `enum std::byte`) and
+// returns the resulting size. With a null `out` only the size is computed.
+constexpr auto strip_type_keywords(std::string_view name,
+                                   char* out) -> std::size_t {
+  constexpr std::array<std::string_view, 4> keywords = {"struct ", "class ",
+                                                        "enum ", "union "};
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < name.size();) {
+    bool skipped = false;
+    if (i == 0 || !is_identifier_char(name[i - 1])) {
+      for (auto keyword : keywords) {
+        if (name.substr(i, keyword.size()) == keyword) {
+          i += keyword.size();
+          skipped = true;
+          break;
+        }
+      }
+    }
+    if (!skipped) {
+      if (out != nullptr) {
+        out[size] = name[i];
+      }
+      ++size;
+      ++i;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+struct clean_type_name {
+  static constexpr auto buffer = [] {
+    constexpr auto raw = raw_type_name<T>();
+    std::array<char, strip_type_keywords(raw, nullptr) + 1> buf{};
+    strip_type_keywords(raw, buf.data());
+    return buf;
+  }();
+  static constexpr std::string_view value{buffer.data(), buffer.size() - 1};
+};
+
+// Concatenates static string_views into a single static buffer at compile
+// time.
+template <const std::string_view&... Parts>
+struct join {
+  static constexpr auto buffer = [] {
+    std::array<char, (Parts.size() + ... + 0) + 1> buf{};
+    std::size_t i = 0;
+    for (auto part : {Parts...}) {
+      for (auto c : part) {
+        buf[i++] = c;
+      }
+    }
+    return buf;
+  }();
+  static constexpr std::string_view value{buffer.data(), buffer.size() - 1};
+};
+
+template <>
+struct join<> {
+  static constexpr std::string_view value{};
+};
+
+template <std::size_t N>
+struct number_name {
+  static constexpr auto buffer = [] {
+    constexpr std::size_t digits = [] {
+      std::size_t d = 1;
+      for (auto n = N; n >= 10; n /= 10) {
+        ++d;
+      }
+      return d;
+    }();
+    std::array<char, digits> buf{};
+    auto n = N;
+    for (std::size_t i = digits; i-- > 0; n /= 10) {
+      buf[i] = static_cast<char>('0' + (n % 10));
+    }
+    return buf;
+  }();
+  static constexpr std::string_view value{buffer.data(), buffer.size()};
+};
+
+struct name_part {
+  static constexpr std::string_view comma = ", ";
+  static constexpr std::string_view close = ">";
+  static constexpr std::string_view vector = "std::vector<";
+  static constexpr std::string_view array = "std::array<";
+  static constexpr std::string_view deque = "std::deque<";
+  static constexpr std::string_view forward_list = "std::forward_list<";
+  static constexpr std::string_view list = "std::list<";
+  static constexpr std::string_view map = "std::map<";
+  static constexpr std::string_view unordered_map = "std::unordered_map<";
+  static constexpr std::string_view multimap = "std::multimap<";
+  static constexpr std::string_view unordered_multimap =
+      "std::unordered_multimap<";
+  static constexpr std::string_view set = "std::set<";
+  static constexpr std::string_view unordered_set = "std::unordered_set<";
+  static constexpr std::string_view multiset = "std::multiset<";
+  static constexpr std::string_view unordered_multiset =
+      "std::unordered_multiset<";
+  static constexpr std::string_view stack = "std::stack<";
+  static constexpr std::string_view queue = "std::queue<";
+  static constexpr std::string_view priority_queue = "std::priority_queue<";
+  static constexpr std::string_view pair = "std::pair<";
+  static constexpr std::string_view tuple = "std::tuple<";
+  static constexpr std::string_view optional = "std::optional<";
+};
+
+}  // namespace detail
+
+// Compile-time name of `T`. Standard containers and vocabulary types with
+// default allocators, comparators and hashers are spelled the way they are
+// written in source; everything else is taken from the compiler's function
+// signature. Specialize this to rename a type.
+template <typename T>
+struct type_name_of {
+  static constexpr std::string_view value = detail::clean_type_name<T>::value;
+};
+
+template <>
+struct type_name_of<std::string> {
+  static constexpr std::string_view value = "std::string";
+};
+
+template <>
+struct type_name_of<std::string_view> {
+  static constexpr std::string_view value = "std::string_view";
+};
+
+namespace detail {
+
+// Name of a single-parameter template instantiation `Prefix T>`.
+template <const std::string_view& Prefix, typename T>
+using unary_name =
+    join<Prefix, type_name_of<T>::value, name_part::close>;
+
+template <const std::string_view& Prefix, typename K, typename V>
+using binary_name = join<Prefix,
+                         type_name_of<K>::value,
+                         name_part::comma,
+                         type_name_of<V>::value,
+                         name_part::close>;
+
+}  // namespace detail
+
+template <typename T>
+struct type_name_of<std::vector<T>>
+    : detail::unary_name<detail::name_part::vector, T> {};
+
+template <typename T, std::size_t N>
+struct type_name_of<std::array<T, N>>
+    : detail::join<detail::name_part::array,
+                   type_name_of<T>::value,
+                   detail::name_part::comma,
+                   detail::number_name<N>::value,
+                   detail::name_part::close> {};
+
+template <typename T>
+struct type_name_of<std::deque<T>>
+    : detail::unary_name<detail::name_part::deque, T> {};
+
+template <typename T>
+struct type_name_of<std::forward_list<T>>
+    : detail::unary_name<detail::name_part::forward_list, T> {};
+
+template <typename T>
+struct type_name_of<std::list<T>>
+    : detail::unary_name<detail::name_part::list, T> {};
+
+template <typename K, typename V>
+struct type_name_of<std::map<K, V>>
+    : detail::binary_name<detail::name_part::map, K, V> {};
+
+template <typename K, typename V>
+struct type_name_of<std::unordered_map<K, V>>
+    : detail::binary_name<detail::name_part::unordered_map, K, V> {};
+
+template <typename K, typename V>
+struct type_name_of<std::multimap<K, V>>
+    : detail::binary_name<detail::name_part::multimap, K, V> {};
+
+template <typename K, typename V>
+struct type_name_of<std::unordered_multimap<K, V>>
+    : detail::binary_name<detail::name_part::unordered_multimap, K, V> {};
+
+template <typename T>
+struct type_name_of<std::set<T>>
+    : detail::unary_name<detail::name_part::set, T> {};
+
+template <typename T>
+struct type_name_of<std::unordered_set<T>>
+    : detail::unary_name<detail::name_part::unordered_set, T> {};
+
+template <typename T>
+struct type_name_of<std::multiset<T>>
+    : detail::unary_name<detail::name_part::multiset, T> {};
+
+template <typename T>
+struct type_name_of<std::unordered_multiset<T>>
+    : detail::unary_name<detail::name_part::unordered_multiset, T> {};
+
+template <typename T>
+struct type_name_of<std::stack<T>>
+    : detail::unary_name<detail::name_part::stack, T> {};
+
+template <typename T>
+struct type_name_of<std::queue<T>>
+    : detail::unary_name<detail::name_part::queue, T> {};
+
+template <typename T>
+struct type_name_of<std::priority_queue<T>>
+    : detail::unary_name<detail::name_part::priority_queue, T> {};
+
+template <typename T1, typename T2>
+struct type_name_of<std::pair<T1, T2>>
+    : detail::binary_name<detail::name_part::pair, T1, T2> {};
+
+template <typename T>
+struct type_name_of<std::optional<T>>
+    : detail::unary_name<detail::name_part::optional, T> {};
+
+namespace detail {
+
+template <typename... Args>
+struct tuple_name;
+
+template <>
+struct tuple_name<> : join<name_part::tuple, name_part::close> {};
+
+template <typename First, typename... Rest>
+struct tuple_name<First, Rest...> {
+  // Builds "std::tuple<A" then appends ", B" for each remaining type.
+  template <const std::string_view& Acc, typename... Ts>
+  struct fold : join<Acc, name_part::close> {};
+
+  template <const std::string_view& Acc, typename T, typename... Ts>
+  struct fold<Acc, T, Ts...>
+      : fold<join<Acc, name_part::comma, type_name_of<T>::value>::value,
+             Ts...> {};
+
+  static constexpr std::string_view value =
+      fold<join<name_part::tuple, type_name_of<First>::value>::value,
+           Rest...>::value;
+};
+
+}  // namespace detail
+
+template <typename... Args>
+struct type_name_of<std::tuple<Args...>> : detail::tuple_name<Args...> {};
+
+template <typename T>
+constexpr auto type_name() -> std::string_view {
+  return type_name_of<std::remove_cv_t<T>>::value;
+}
+
+namespace detail {
+
+// Whether the inspected form of `T` carries its own brackets, so an
+// annotation can be prefixed directly instead of wrapping it in braces.
+template <typename T, typename = void>
+constexpr bool has_container_type = false;
+
+template <typename T>
+constexpr bool has_container_type<T, std::void_t<typename T::container_type>> =
+    true;
+
+template <typename T>
+constexpr bool is_self_delimited_v =
+    !has_inspect_member<T> && !has_adl_inspect<T> &&
+    (is_tuple_like_v<T> || has_container_type<T> ||
+     (std::ranges::range<const T> &&
+      !std::is_convertible_v<const T&, std::string_view> &&
+      !is_byte_range_v<T>));
+
+template <typename T>
+struct annotated_wrapper {
+  const T* obj;
+
+  template <typename Style = default_style>
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    os << type_name<T>();
+    if constexpr (is_self_delimited_v<T>) {
+      return os << make_inspectable<Style>(*obj);
+    } else {
+      return os << '{' << make_inspectable<Style>(*obj) << '}';
+    }
+  }
+};
+
+}  // namespace detail
+
+// Prefixes the inspected value with its compile-time type name, e.g.
+// `std::map<int, std::string>{1: a}` or `int{42}`. Only the outermost value
+// is annotated.
+template <typename T>
+auto annotated(const T& obj) -> detail::annotated_wrapper<T> {
+  return detail::annotated_wrapper<T>{&obj};
+}
+
+}  // namespace insp
@@ -10,22 +10,25 @@ namespace insp {
 
 template <typename T1, typename T2>
 struct inspector<std::pair<T1, T2>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::pair<T1, T2>& obj) -> std::ostream& {
-    return os << '(' << make_inspectable(obj.first) << ", "
-              << make_inspectable(obj.second) << ')';
+    return os << '(' << make_inspectable<Style>(obj.first) << Style::separator
+              << make_inspectable<Style>(obj.second) << ')';
   }
 };
 
 namespace detail {
 
-template <typename Tuple, std::size_t... I>
+template <typename Style, typename Tuple, std::size_t... I>
 auto tuple_inspect_impl(std::ostream& os,
                         const Tuple& obj,
                         std::index_sequence<I...> /*unused*/) -> std::ostream& {
   os << '(';
   if constexpr (sizeof...(I) > 0) {
-    ((os << (I == 0 ? "" : ", ") << make_inspectable(std::get<I>(obj))), ...);
+    (((I == 0 ? os : os << Style::separator)
+      << make_inspectable<Style>(std::get<I>(obj))),
+     ...);
   }
   return os << ')';
 }
@@ -34,9 +37,10 @@ auto tuple_inspect_impl(std::ostream& os,
 
 template <typename... Args>
 struct inspector<std::tuple<Args...>> {
+  template <typename Style = default_style>
   static auto inspect(std::ostream& os,
                       const std::tuple<Args...>& obj) -> std::ostream& {
-    return detail::tuple_inspect_impl(
+    return detail::tuple_inspect_impl<Style>(
         os, obj, std::make_index_sequence<sizeof...(Args)>{});
   }
 };
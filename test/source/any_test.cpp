@@ -0,0 +1,185 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/any.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/fingerprint.hpp>
+#include <inspector/utility.hpp>  // IWYU pragma: keep
+
+// Every global allocation in the test binary is counted so the tests below
+// can assert that type erasure itself does not allocate.
+namespace {
+
+std::atomic<std::size_t> allocation_count{0};
+
+// Kept out of line so the compiler does not pair `free` with `new`.
+[[gnu::noinline]] void release(void* p) noexcept {
+  std::free(p);  // NOLINT
+}
+
+}  // namespace
+
+auto operator new(std::size_t size) -> void* {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {  // NOLINT
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+auto operator new[](std::size_t size) -> void* {
+  return ::operator new(size);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+    -> void* {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);  // NOLINT
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+    -> void* {
+  return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+  release(p);
+}
+
+void operator delete[](void* p) noexcept {
+  release(p);
+}
+
+void operator delete(void* p, std::size_t /*size*/) noexcept {
+  release(p);
+}
+
+void operator delete[](void* p, std::size_t /*size*/) noexcept {
+  release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t& /*tag*/) noexcept {
+  release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t& /*tag*/) noexcept {
+  release(p);
+}
+
+namespace {
+
+auto allocations() -> std::size_t {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+struct point {
+  int x;
+  int y;
+
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    return os << '(' << x << ", " << y << ')';
+  }
+};
+
+struct big {
+  std::array<char, 64> payload{};
+};
+
+auto inspect(std::ostream& os, const big& /*obj*/) -> std::ostream& {
+  return os << "big";
+}
+
+// A non-template interface taking heterogeneous arguments.
+auto fingerprint_args(const insp::any_inspectable* args,
+                      std::size_t count) -> std::uint64_t {
+  insp::fingerprint_stream fs;
+  for (std::size_t i = 0; i < count; ++i) {
+    fs << (i == 0 ? "" : " ") << insp::make_inspectable(args[i]);  // NOLINT
+  }
+  return fs.digest();
+}
+
+}  // namespace
+
+TEST_CASE("Inspect type-erased values", "[any]") {
+  SECTION("dispatches to member, ADL and inspector<T>") {
+    const std::vector<int> vec{1, 2};
+    REQUIRE(insp::to_string(insp::any_inspectable(point{1, 2})) == "(1, 2)");
+    REQUIRE(insp::to_string(insp::any_inspectable(big{})) == "big");
+    REQUIRE(insp::to_string(insp::any_inspectable(vec)) == "[1, 2]");
+    REQUIRE(insp::to_string(insp::any_inspectable(std::make_pair(1, 'x'))) ==
+            "(1, x)");
+    REQUIRE(insp::to_string(insp::any_inspectable("text")) == "text");
+    REQUIRE(insp::to_string(insp::any_inspectable()).empty());
+  }
+
+  SECTION("small values are stored inline") {
+    REQUIRE(insp::any_inspectable(42).stored_inline());
+    REQUIRE(insp::any_inspectable(point{}).stored_inline());
+    REQUIRE(insp::any_inspectable(std::string_view("sv")).stored_inline());
+    REQUIRE_FALSE(insp::any_inspectable(big{}).stored_inline());
+    REQUIRE_FALSE(insp::any_inspectable().stored_inline());
+  }
+
+  SECTION("copy, move and reassignment") {
+    insp::any_inspectable a = std::map<int, std::string>{{1, "one"}};
+    insp::any_inspectable b = a;
+    REQUIRE(insp::to_string(b) == "{1: one}");
+
+    insp::any_inspectable c = std::move(a);
+    REQUIRE_FALSE(a.has_value());  // NOLINT(*-use-after-move)
+    REQUIRE(insp::to_string(c) == "{1: one}");
+
+    b = point{3, 4};
+    c = b;
+    REQUIRE(insp::to_string(c) == "(3, 4)");
+
+    insp::any_inspectable d = big{};
+    swap(c, d);
+    REQUIRE(insp::to_string(c) == "big");
+    REQUIRE(insp::to_string(d) == "(3, 4)");
+
+    d.reset();
+    REQUIRE_FALSE(d.has_value());
+  }
+}
+
+TEST_CASE("Type-erased argument packs do not allocate", "[any]") {
+  const std::string_view expected = "42 (1, 2) hello 2.5 (7, y)";
+
+  SECTION("building, moving and formatting inline values") {
+    const auto before = allocations();
+    {
+      std::array<insp::any_inspectable, 5> args = {
+          42, point{1, 2}, std::string_view("hello"), 2.5,
+          std::make_pair(7, 'y')};
+      auto moved = std::move(args);
+      const auto copied = moved;
+      REQUIRE(fingerprint_args(copied.data(), copied.size()) ==
+              insp::fingerprint_text(expected));
+    }
+    REQUIRE(allocations() == before);
+  }
+
+  SECTION("large values allocate once each") {
+    const auto before = allocations();
+    {
+      insp::any_inspectable a = big{};
+      insp::any_inspectable b = std::move(a);
+      REQUIRE(allocations() - before == 1);
+      const insp::any_inspectable c = b;
+      REQUIRE(allocations() - before == 2);
+    }
+  }
+}
@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/batch.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/utility.hpp>  // IWYU pragma: keep
+
+namespace {
+
+class counting_resource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+
+ private:
+  auto do_allocate(std::size_t bytes, std::size_t alignment)
+      -> void* override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Inspect objects in a batch", "[batch]") {
+  SECTION("heterogeneous arguments") {
+    insp::batch b;
+    const std::map<std::string, int> m{{"one", 1}};
+    b.add_all(42, std::string("hello"), std::vector<int>{1, 2}, m,
+              std::make_tuple(1, 'x'));
+    REQUIRE(b.size() == 5);
+    REQUIRE(b[0] == "42");
+    REQUIRE(b[1] == "hello");
+    REQUIRE(b[2] == "[1, 2]");
+    REQUIRE(b[3] == "{one: 1}");
+    REQUIRE(b[4] == "(1, x)");
+    REQUIRE(b.text() == "42hello[1, 2]{one: 1}(1, x)");
+    REQUIRE(b.entries()[2].offset == 7);
+    REQUIRE(b.entries()[2].length == 6);
+  }
+
+  SECTION("empty output still gets an entry") {
+    insp::batch b;
+    b.add(std::string());
+    b.add(1);
+    REQUIRE(b.size() == 2);
+    REQUIRE(b[0].empty());
+    REQUIRE(b[1] == "1");
+  }
+
+  SECTION("range of records") {
+    std::vector<std::vector<int>> records;
+    for (int i = 0; i < 100; ++i) {
+      records.push_back({i, i * 2});
+    }
+    insp::batch b;
+    b.add_range(records);
+    REQUIRE(b.size() == records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      REQUIRE(b[i] == insp::to_string(records[i]));
+    }
+  }
+
+  SECTION("clear keeps the arena") {
+    insp::batch b;
+    b.add(123);
+    b.clear();
+    REQUIRE(b.empty());
+    b.add(4);
+    REQUIRE(b[0] == "4");
+    REQUIRE(b.text() == "4");
+  }
+
+  SECTION("allocations do not scale with the number of records") {
+    counting_resource upstream;
+    {
+      insp::batch b(insp::batch::default_initial_size, &upstream);
+      for (int i = 0; i < 10000; ++i) {
+        b.add_all(i, std::string("record"), std::vector<int>{i, i + 1});
+      }
+      REQUIRE(b.size() == 30000);
+      REQUIRE(b[29999] == "[9999, 10000]");
+    }
+    REQUIRE(upstream.allocations < 64);
+  }
+}
@@ -0,0 +1,94 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/bytes.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/type_name.hpp>
+
+TEST_CASE("Inspect byte containers as hex", "[bytes]") {
+  SECTION("std::byte containers default to compact hex") {
+    const std::vector<std::byte> vec{std::byte{0x0a}, std::byte{0xff},
+                                     std::byte{0x10}};
+    REQUIRE(insp::to_string(vec) == "0aff10");
+
+    const std::array<std::byte, 2> arr{std::byte{0x00}, std::byte{0xab}};
+    REQUIRE(insp::to_string(arr) == "00ab");
+
+    REQUIRE(insp::to_string(std::vector<std::byte>{}).empty());
+    REQUIRE(insp::to_string(std::byte{0x7f}) == "7f");
+  }
+
+  SECTION("nested byte buffers") {
+    const std::vector<std::vector<std::byte>> vec{{std::byte{1}},
+                                                  {std::byte{2}}};
+    REQUIRE(insp::to_string(vec) == "[01, 02]");
+  }
+
+  SECTION("unsigned char containers default to compact hex") {
+    const std::vector<unsigned char> uc{0xde, 0xad, 0xbe, 0xef};
+    REQUIRE(insp::to_string(uc) == "deadbeef");
+
+    const std::array<std::uint8_t, 3> u8{1, 2, 3};
+    REQUIRE(insp::to_string(u8) == "010203");
+    REQUIRE(insp::to_string(insp::as_hex(u8)) == "010203");
+  }
+
+  SECTION("other byte-like ranges opt in") {
+    const std::string str = "AZ";
+    REQUIRE(insp::to_string(insp::as_hex(str)) == "415a");
+
+    const std::vector<signed char> sc{-1, 1};
+    REQUIRE(insp::to_string(sc) != "ff01");
+    REQUIRE(insp::to_string(insp::as_hex(sc)) == "ff01");
+  }
+
+  SECTION("vector paths match the scalar encoder") {
+    std::vector<unsigned char> data(300);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<unsigned char>((i * 37U) ^ (i >> 3U));
+    }
+    using insp::detail::hex_isa;
+    for (const auto isa : {hex_isa::scalar, hex_isa::sse2, hex_isa::ssse3,
+                           hex_isa::avx2}) {
+      if (!insp::detail::hex_isa_supported(isa)) {
+        continue;
+      }
+      for (std::size_t n = 0; n <= data.size(); n += 7) {
+        std::string simd(2 * n, '\0');
+        std::string scalar(2 * n, '\0');
+        insp::detail::hex_encode_with(isa, data.data(), n, simd.data());
+        insp::detail::hex_encode_scalar(data.data(), n, scalar.data());
+        REQUIRE(simd == scalar);
+      }
+    }
+  }
+
+  SECTION("annotation keeps hex unbracketed") {
+    REQUIRE(insp::to_string(insp::annotated(std::vector<std::byte>{
+                std::byte{1}})) == "std::vector<std::byte>{01}");
+  }
+}
+
+TEST_CASE("Inspect byte containers as an xxd-style dump", "[bytes]") {
+  SECTION("full and partial lines") {
+    std::vector<unsigned char> data;
+    for (unsigned char c = 0x40; c < 0x40 + 20; ++c) {
+      data.push_back(c);
+    }
+    data.push_back(0x00);
+    REQUIRE(insp::to_string(insp::as_hexdump(data)) ==
+            "00000000: 4041 4243 4445 4647 4849 4a4b 4c4d 4e4f  "
+            "@ABCDEFGHIJKLMNO\n"
+            "00000010: 5051 5253 00                             PQRS.");
+  }
+
+  SECTION("empty range") {
+    REQUIRE(insp::to_string(insp::as_hexdump(std::vector<std::byte>{}))
+                .empty());
+  }
+}
@@ -83,3 +83,103 @@ TEST_CASE("Inspect std::chrono::duration", "[chrono]") {
     }
   }
 }
+
+TEST_CASE("Inspect humanized std::chrono::duration", "[chrono]") {
+  using namespace std::chrono_literals;
+
+  SECTION("sub-minute values use two decimals") {
+    REQUIRE(insp::to_string(insp::humanized(123456789ns)) == "123.46ms");
+    REQUIRE(insp::to_string(insp::humanized(1500ns)) == "1.50us");
+    REQUIRE(insp::to_string(insp::humanized(2500ms)) == "2.50s");
+    REQUIRE(insp::to_string(insp::humanized(1s)) == "1.00s");
+  }
+
+  SECTION("small values stay in nanoseconds") {
+    REQUIRE(insp::to_string(insp::humanized(999ns)) == "999ns");
+    REQUIRE(insp::to_string(insp::humanized(0ns)) == "0s");
+  }
+
+  SECTION("rounding carries into the next unit") {
+    REQUIRE(insp::to_string(insp::humanized(999996ns)) == "1.00ms");
+    REQUIRE(insp::to_string(insp::humanized(59996ms)) == "1m00s");
+  }
+
+  SECTION("long values are split into components") {
+    REQUIRE(insp::to_string(insp::humanized(3723s)) == "1h02m03s");
+    REQUIRE(insp::to_string(insp::humanized(125s)) == "2m05s");
+    REQUIRE(insp::to_string(insp::humanized(std::chrono::days{2} + 5s)) ==
+            "2d00h00m05s");
+    REQUIRE(insp::to_string(insp::humanized(std::chrono::hours{1})) ==
+            "1h00m00s");
+  }
+
+  SECTION("negative values") {
+    REQUIRE(insp::to_string(insp::humanized(-1500us)) == "-1.50ms");
+    REQUIRE(insp::to_string(insp::humanized(-3723s)) == "-1h02m03s");
+    REQUIRE(insp::to_string(insp::humanized(std::chrono::nanoseconds::min())) ==
+            "-106751d23h47m17s");
+  }
+
+  SECTION("floating point representation") {
+    using fp_seconds = std::chrono::duration<double>;
+    REQUIRE(insp::to_string(insp::humanized(fp_seconds{0.25})) == "250.00ms");
+    REQUIRE(insp::to_string(insp::humanized(fp_seconds{-90.0})) == "-1m30s");
+    REQUIRE(insp::to_string(insp::humanized(fp_seconds{1e300})) == "1e+300s");
+    using fp_thirds = std::chrono::duration<double, std::ratio<1, 3>>;
+    REQUIRE(insp::to_string(insp::humanized(fp_thirds{3e300})) == "1e+300s");
+  }
+
+  SECTION("float and double representations") {
+    using float_seconds = std::chrono::duration<float>;
+    using float_millis = std::chrono::duration<float, std::milli>;
+    REQUIRE(insp::to_string(insp::humanized(float_seconds{0.25F})) ==
+            "250.00ms");
+    REQUIRE(insp::to_string(insp::humanized(float_seconds{-90.0F})) ==
+            "-1m30s");
+    REQUIRE(insp::to_string(insp::humanized(float_millis{1.5F})) == "1.50ms");
+    REQUIRE(insp::to_string(insp::humanized(float_seconds{1e20F})) ==
+            "1e+20s");
+    using double_millis = std::chrono::duration<double, std::milli>;
+    REQUIRE(insp::to_string(insp::humanized(double_millis{2500.0})) ==
+            "2.50s");
+    REQUIRE(insp::to_string(insp::humanized(double_millis{-0.5})) ==
+            "-500.00us");
+  }
+
+  SECTION("counts beyond the range of seconds") {
+    using u64_seconds = std::chrono::duration<unsigned long long>;
+    REQUIRE(insp::to_string(insp::humanized(u64_seconds{~0ULL})) ==
+            "213503982334601d07h00m15s");
+    using gigaseconds = std::chrono::duration<long long, std::giga>;
+    REQUIRE(insp::to_string(insp::humanized(gigaseconds{3})) ==
+            "34722d05h20m00s");
+    REQUIRE(insp::to_string(insp::humanized(gigaseconds{20'000'000'000})) ==
+            "2e+19s");
+    REQUIRE(insp::to_string(insp::humanized(-gigaseconds{20'000'000'000})) ==
+            "-2e+19s");
+  }
+
+  SECTION("arbitrary periods") {
+    using thirds = std::chrono::duration<int, std::ratio<1, 3>>;
+    REQUIRE(insp::to_string(insp::humanized(thirds{1})) == "333.33ms");
+    using five_seconds = std::chrono::duration<int, std::ratio<5>>;
+    REQUIRE(insp::to_string(insp::humanized(five_seconds{13})) == "1m05s");
+    using picoseconds = std::chrono::duration<long long, std::pico>;
+    REQUIRE(insp::to_string(insp::humanized(picoseconds{1500})) == "2ns");
+  }
+
+  SECTION("stream formatting state is ignored") {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(5) << std::setfill('*');
+    ss << insp::make_inspectable(insp::humanized(123456789ns));
+    REQUIRE(ss.str() == "123.46ms");
+  }
+
+  SECTION("width pads the whole value and is consumed") {
+    std::stringstream ss;
+    ss << std::setw(10) << insp::make_inspectable(insp::humanized(5ms)) << '|'
+       << std::setw(10) << std::left
+       << insp::make_inspectable(insp::humanized(3723s)) << '|';
+    REQUIRE(ss.str() == "    5.00ms|1h02m03s  |");
+  }
+}
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/fingerprint.hpp>
+#include <inspector/optional.hpp>  // IWYU pragma: keep
+#include <inspector/utility.hpp>   // IWYU pragma: keep
+
+TEST_CASE("Fingerprint text with XXH64", "[fingerprint]") {
+  SECTION("reference values") {
+    REQUIRE(insp::fingerprint_text("") == 0xEF46DB3751D8E999ULL);
+    REQUIRE(insp::fingerprint_text("a") == 0xD24EC4F1A98C6E5BULL);
+    REQUIRE(insp::fingerprint_text("abc") == 0x44BC2CF5AD770999ULL);
+    REQUIRE(insp::fingerprint_text(
+                "Nobody inspects the spammish repetition") ==
+            0xFBCEA83C8A378BF1ULL);
+  }
+
+  SECTION("chunking does not change the digest") {
+    const std::string text(1000, 'q');
+    insp::fingerprint_stream fs;
+    for (const char c : text) {
+      fs << c;
+    }
+    REQUIRE(fs.digest() == insp::fingerprint_text(text));
+    REQUIRE(fs.length() == text.size());
+
+    fs.reset();
+    fs << text.substr(0, 7) << text.substr(7, 50) << text.substr(57);
+    REQUIRE(fs.digest() == insp::fingerprint_text(text));
+  }
+
+  SECTION("seed changes the digest") {
+    REQUIRE(insp::fingerprint_text("abc", 1) !=
+            insp::fingerprint_text("abc"));
+  }
+}
+
+TEST_CASE("Fingerprint inspected objects", "[fingerprint]") {
+  SECTION("matches hashing to_string output") {
+    const std::map<std::string, std::vector<int>> m{
+        {"alpha", {1, 2, 3}}, {"beta", {}}, {std::string(40, 'g'), {7}}};
+    REQUIRE(insp::fingerprint(m) == insp::fingerprint_text(insp::to_string(m)));
+
+    const auto t = std::make_tuple(1, std::string("x"), std::optional<int>{});
+    REQUIRE(insp::fingerprint(t, 42) ==
+            insp::fingerprint_text(insp::to_string(t), 42));
+  }
+
+  SECTION("different objects differ") {
+    REQUIRE(insp::fingerprint(std::vector<int>{1, 2}) !=
+            insp::fingerprint(std::vector<int>{1, 3}));
+  }
+}
+
+TEST_CASE("Binary fingerprint", "[fingerprint]") {
+  SECTION("is deterministic") {
+    const std::vector<double> v{1.5, 2.5, 3.5};
+    REQUIRE(insp::binary_fingerprint(v) ==
+            insp::binary_fingerprint(std::vector<double>{1.5, 2.5, 3.5}));
+  }
+
+  SECTION("distinguishes values and structure") {
+    using nested = std::vector<std::vector<int>>;
+    REQUIRE(insp::binary_fingerprint(nested{{1, 2}, {3}}) !=
+            insp::binary_fingerprint(nested{{1}, {2, 3}}));
+    REQUIRE(insp::binary_fingerprint(std::vector<int>{1, 2}) !=
+            insp::binary_fingerprint(std::vector<int>{1, 2, 0}));
+    REQUIRE(insp::binary_fingerprint(std::optional<int>{}) !=
+            insp::binary_fingerprint(std::optional<int>{0}));
+  }
+
+  SECTION("handles empty ranges") {
+    REQUIRE(insp::binary_fingerprint(std::vector<int>{}) ==
+            insp::binary_fingerprint(std::vector<int>{}));
+    REQUIRE(insp::binary_fingerprint(std::vector<int>{}) !=
+            insp::binary_fingerprint(std::vector<int>{0}));
+    REQUIRE(insp::fingerprint(std::string_view{}) ==
+            insp::fingerprint_text(""));
+  }
+
+  SECTION("handles non-contiguous and mixed containers") {
+    const std::map<std::string, std::vector<std::uint8_t>> m{
+        {"a", {1, 2}}, {"b", {3}}};
+    auto copy = m;
+    REQUIRE(insp::binary_fingerprint(m) == insp::binary_fingerprint(copy));
+    copy["b"].push_back(4);
+    REQUIRE(insp::binary_fingerprint(m) != insp::binary_fingerprint(copy));
+  }
+
+  SECTION("hashes self-printing ranges through their text") {
+    // Each element of a path is a path, so walking it would never end.
+    const std::filesystem::path p("a/b");
+    REQUIRE(insp::binary_fingerprint(p) ==
+            insp::binary_fingerprint(std::filesystem::path("a/b")));
+    REQUIRE(insp::binary_fingerprint(p) !=
+            insp::binary_fingerprint(std::filesystem::path("a/c")));
+    REQUIRE(insp::binary_fingerprint(std::vector{p}) !=
+            insp::binary_fingerprint(std::vector<std::filesystem::path>{}));
+  }
+}
@@ -0,0 +1,121 @@
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/fragments.hpp>
+
+#if __has_include(<sys/uio.h>)
+#  include <cstdio>
+
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+auto join(const std::vector<insp::fragment>& frags) -> std::string {
+  std::string out;
+  for (const auto& f : frags) {
+    out.append(f.data, f.size);
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("Inspect into a fragment list", "[fragments]") {
+  const std::string large(100, 'x');
+  const std::string small = "abc";
+
+  SECTION("output matches to_string") {
+    const std::map<std::string, std::vector<std::string>> obj{
+        {"k", {large, small}}, {small, {}}};
+    insp::fragment_stream fs;
+    fs << insp::make_inspectable(obj);
+    REQUIRE(join(fs.fragments()) == insp::to_string(obj));
+  }
+
+  SECTION("large strings are referenced in place") {
+    const std::vector<std::string> obj{large, small, large};
+    insp::fragment_stream fs;
+    fs << insp::make_inspectable(obj);
+    const auto& frags = fs.fragments();
+    REQUIRE(frags.size() == 5);  // "[", large, ", abc, ", large, "]"
+    REQUIRE(frags[1].data == obj[0].data());
+    REQUIRE(frags[3].data == obj[2].data());
+    REQUIRE(std::string_view(frags[2].data, frags[2].size) == ", abc, ");
+  }
+
+  SECTION("string_view leaves are referenced too") {
+    const std::vector<std::string_view> obj{large};
+    insp::fragment_stream fs;
+    fs << insp::make_inspectable(obj);
+    REQUIRE(fs.fragments().size() == 3);
+    REQUIRE(fs.fragments()[1].data == large.data());
+  }
+
+  SECTION("threshold is configurable") {
+    const std::vector<std::string> obj{small};
+    insp::fragment_stream fs(1);
+    fs << insp::make_inspectable(obj);
+    REQUIRE(fs.fragments()[1].data == obj[0].data());
+  }
+
+  SECTION("padded leaves are copied and consume the width") {
+    const std::string str = "abc";
+    insp::fragment_stream fs(1);
+    fs << std::setw(6) << insp::make_inspectable(str) << "|";
+    std::ostringstream os;
+    os << std::setw(6) << insp::make_inspectable(str) << "|";
+    REQUIRE(join(fs.fragments()) == os.str());
+    REQUIRE(join(fs.fragments()) == "   abc|");
+
+    // Containers pass the width on to their opening bracket.
+    const std::vector<std::string> vec{str};
+    fs.reset();
+    os.str("");
+    fs << std::setw(3) << insp::make_inspectable(vec);
+    os << std::setw(3) << insp::make_inspectable(vec);
+    REQUIRE(join(fs.fragments()) == os.str());
+  }
+
+  SECTION("reset starts a new list") {
+    insp::fragment_stream fs;
+    fs << insp::make_inspectable(large);
+    fs.reset();
+    fs << insp::make_inspectable(small);
+    REQUIRE(join(fs.fragments()) == small);
+  }
+
+  SECTION("ordinary streams still copy") {
+    REQUIRE(insp::to_string(std::vector<std::string>{large}) ==
+            "[" + large + "]");
+  }
+
+#if __has_include(<sys/uio.h>)
+  SECTION("iovecs can be passed to writev") {
+    const std::vector<std::string> obj{large, small};
+    insp::fragment_stream fs;
+    fs << insp::make_inspectable(obj);
+    auto iov = fs.iovecs();
+
+    std::FILE* tmp = std::tmpfile();
+    REQUIRE(tmp != nullptr);
+    const int fd = ::fileno(tmp);
+    const auto written =
+        ::writev(fd, iov.data(), static_cast<int>(iov.size()));
+    REQUIRE(written == static_cast<ssize_t>(insp::to_string(obj).size()));
+
+    std::string read_back(static_cast<std::size_t>(written), '\0');
+    REQUIRE(::pread(fd, read_back.data(), read_back.size(), 0) == written);
+    REQUIRE(read_back == insp::to_string(obj));
+    std::fclose(tmp);
+  }
+#endif
+}
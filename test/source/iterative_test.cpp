@@ -0,0 +1,217 @@
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/bytes.hpp>       // IWYU pragma: keep
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/iterative.hpp>
+#include <inspector/optional.hpp>  // IWYU pragma: keep
+#include <inspector/utility.hpp>   // IWYU pragma: keep
+
+namespace {
+
+struct tag {
+  int id;
+
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    return os << "tag#" << id;
+  }
+};
+
+struct node {
+  int value;
+  std::vector<node> children;
+};
+
+auto inspect_as(const node& n) {
+  return std::tie(n.value, n.children);
+}
+
+// Nodes of a chain far too deep for recursive inspection. The chain is
+// stored flat so that building and destroying it does not recurse either.
+struct chain {
+  std::size_t length;
+};
+
+struct chain_link {
+  const chain* owner;
+  std::size_t index;
+};
+
+auto inspect_as(const chain_link& l)
+    -> std::pair<std::size_t, std::vector<chain_link>> {
+  std::vector<chain_link> next;
+  if (l.index + 1 < l.owner->length) {
+    next.push_back({l.owner, l.index + 1});
+  }
+  return {l.index, std::move(next)};
+}
+
+// Range whose iterators count their live instances, padded with `Pad` bytes
+// so that they may be too large for a frame.
+int live_iterators = 0;
+
+template <typename T, std::size_t Pad>
+struct tracked_range {
+  std::vector<T> values;
+
+  struct iterator {
+    typename std::vector<T>::const_iterator pos;
+    std::array<char, Pad> pad{};
+
+    explicit iterator(typename std::vector<T>::const_iterator p) : pos(p) {
+      ++live_iterators;
+    }
+    iterator(const iterator& other) : pos(other.pos) { ++live_iterators; }
+    iterator(iterator&& other) noexcept : pos(other.pos) { ++live_iterators; }
+    auto operator=(const iterator& other) -> iterator& = default;
+    auto operator=(iterator&& other) noexcept -> iterator& = default;
+    ~iterator() { --live_iterators; }
+
+    auto operator*() const -> const T& { return *pos; }
+    auto operator++(int) -> iterator {
+      auto old = *this;
+      ++pos;
+      return old;
+    }
+    auto operator==(const iterator& other) const -> bool {
+      return pos == other.pos;
+    }
+  };
+
+  auto begin() const -> iterator { return iterator(values.begin()); }
+  auto end() const -> iterator { return iterator(values.end()); }
+};
+
+struct faulty {};
+
+auto inspect_as(const faulty& /*unused*/) -> std::vector<int> {
+  throw std::runtime_error("faulty");
+}
+
+struct throwing {
+  auto inspect(std::ostream& /*unused*/) const -> std::ostream& {
+    throw std::runtime_error("throwing");
+  }
+};
+
+template <typename T>
+auto iterative_string(const T& obj) -> std::string {
+  return insp::to_string(insp::iterative(obj));
+}
+
+}  // namespace
+
+namespace insp::detail {
+
+template <typename T, std::size_t Pad>
+constexpr bool is_traversable_sequence_v<tracked_range<T, Pad>> = true;
+
+}  // namespace insp::detail
+
+TEST_CASE("Inspect iteratively", "[iterative]") {
+  SECTION("matches recursive inspection") {
+    const std::vector<std::map<std::string, std::vector<std::tuple<int, char>>>>
+        nested{{{"a", {{1, 'x'}, {2, 'y'}}}, {"b", {}}}, {}};
+    REQUIRE(iterative_string(nested) == insp::to_string(nested));
+    REQUIRE(iterative_string(nested) ==
+            "[{a: [(1, x), (2, y)], b: []}, {}]");
+
+    const auto mixed = std::make_tuple(
+        std::optional<std::list<int>>{{1, 2}}, std::optional<int>{},
+        std::set<std::pair<int, int>>{{1, 2}},
+        std::deque<std::array<int, 2>>{{3, 4}},
+        std::forward_list<std::vector<bool>>{{true, false}},
+        std::unordered_map<int, tag>{{1, tag{7}}}, std::tuple<>{},
+        std::stack<int>{std::deque<int>{5, 6}}, std::string("str"));
+    REQUIRE(iterative_string(mixed) == insp::to_string(mixed));
+
+    const std::vector<std::vector<std::byte>> bytes{{std::byte{0xab}}};
+    REQUIRE(iterative_string(bytes) == "[ab]");
+    REQUIRE(iterative_string(42) == "42");
+  }
+
+  SECTION("inspect_as views are traversed") {
+    const node tree{1, {{2, {}}, {3, {{4, {}}}}}};
+    REQUIRE(insp::to_string(tree) == "(1, [(2, []), (3, [(4, [])])])");
+    REQUIRE(iterative_string(tree) == insp::to_string(tree));
+  }
+
+  SECTION("depth limit") {
+    const std::vector<std::vector<int>> vv{{1}, {2, 3}};
+    REQUIRE(insp::to_string(insp::iterative(vv, 2)) == "[[1], [2, 3]]");
+    REQUIRE(insp::to_string(insp::iterative(vv, 1)) == "[..., ...]");
+    REQUIRE(insp::to_string(insp::iterative(vv, 0)) == "...");
+
+    const node tree{1, {{2, {{3, {}}}}}};
+    REQUIRE(insp::to_string(insp::iterative(tree, 3)) ==
+            "(1, [(2, ...)])");
+  }
+
+  SECTION("reused engine") {
+    insp::iterative_inspector engine;
+    engine.reserve(16);
+    std::ostringstream os;
+    engine.inspect(os, std::vector<int>{1, 2});
+    engine.inspect(os, std::make_pair(3, std::vector<int>{}));
+    REQUIRE(os.str() == "[1, 2](3, [])");
+  }
+
+  SECTION("iterators that are not trivial or do not fit a frame") {
+    using small = tracked_range<int, 0>;
+    using large = tracked_range<int, 64>;
+    static_assert(insp::detail::fits_frame_v<small::iterator>);
+    static_assert(!insp::detail::fits_frame_v<large::iterator>);
+
+    REQUIRE(iterative_string(small{{1, 2}}) == "[1, 2]");
+    REQUIRE(iterative_string(large{{1, 2}}) == "[1, 2]");
+    const tracked_range<large, 64> nested{{large{{1}}, large{{2, 3}}}};
+    REQUIRE(iterative_string(nested) == "[[1], [2, 3]]");
+    REQUIRE(insp::to_string(insp::iterative(nested, 1)) == "[..., ...]");
+    REQUIRE(live_iterators == 0);
+
+    const tracked_range<throwing, 64> bad{{throwing{}}};
+    REQUIRE_THROWS_AS(iterative_string(bad), std::runtime_error);
+    REQUIRE(live_iterators == 0);
+  }
+
+  SECTION("a throwing inspect_as leaves no frame to destroy") {
+    insp::iterative_inspector engine;
+    std::ostringstream os;
+    engine.inspect(os, std::vector<int>{1, 2, 3});
+    REQUIRE_THROWS_AS(engine.inspect(os, faulty{}), std::runtime_error);
+    engine.inspect(os, std::vector<int>{4});
+    REQUIRE(os.str() == "[1, 2, 3][4]");
+  }
+
+  SECTION("very deep structures use bounded native stack") {
+    constexpr std::size_t depth = 100000;
+    const chain c{depth};
+    const auto out = iterative_string(chain_link{&c, 0});
+
+    std::string expected;
+    for (std::size_t i = 0; i < depth; ++i) {
+      expected += '(' + std::to_string(i) + ", [";
+    }
+    for (std::size_t i = 0; i < depth; ++i) {
+      expected += "])";
+    }
+    REQUIRE(out == expected);
+  }
+}
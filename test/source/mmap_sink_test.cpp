@@ -0,0 +1,169 @@
+#if __has_include(<sys/mman.h>)
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/mmap_sink.hpp>
+#include <unistd.h>
+
+namespace {
+
+class temp_dir {
+  std::filesystem::path path_;
+
+ public:
+  temp_dir()
+      : path_(std::filesystem::temp_directory_path() /
+              ("inspector_mmap_test_" + std::to_string(::getpid()))) {
+    std::filesystem::create_directories(path_);
+  }
+  temp_dir(const temp_dir&) = delete;
+  temp_dir(temp_dir&&) = delete;
+  auto operator=(const temp_dir&) -> temp_dir& = delete;
+  auto operator=(temp_dir&&) -> temp_dir& = delete;
+  ~temp_dir() { std::filesystem::remove_all(path_); }
+
+  auto path() const -> const std::filesystem::path& { return path_; }
+};
+
+auto read_file(const std::string& path) -> std::string {
+  std::ifstream ifs(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << ifs.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+TEST_CASE("Inspect into memory-mapped files", "[mmap_sink]") {
+  const temp_dir dir;
+  const auto base = (dir.path() / "trace.log").string();
+
+  SECTION("single writer") {
+    {
+      insp::mmap_sink sink(base, {.file_size = 4096, .chunk_size = 256});
+      insp::mmap_writer writer(sink);
+      const std::map<std::string, std::vector<int>> obj{{"a", {1, 2}},
+                                                        {"b", {}}};
+      writer << insp::make_inspectable(obj) << '\n';
+      writer.commit();
+      writer << insp::make_inspectable(std::vector<int>{3}) << '\n';
+    }
+    REQUIRE(read_file(base + ".0") == "{a: [1, 2], b: []}\n[3]\n");
+  }
+
+  SECTION("record larger than a chunk stays contiguous") {
+    const std::string payload(1000, 'x');
+    {
+      insp::mmap_sink sink(base, {.file_size = 4096, .chunk_size = 64});
+      insp::mmap_writer writer(sink);
+      writer << "head:";
+      writer << payload;
+      writer.commit();
+    }
+    REQUIRE(read_file(base + ".0") == "head:" + payload);
+  }
+
+  SECTION("rolls over to a new file when full") {
+    insp::mmap_sink sink(base, {.file_size = 128, .chunk_size = 32});
+    {
+      insp::mmap_writer writer(sink);
+      for (int i = 0; i < 20; ++i) {
+        writer << insp::make_inspectable(std::vector<int>{i, i}) << '\n';
+        writer.commit();
+      }
+    }
+    REQUIRE(sink.file_count() > 1);
+  }
+
+  SECTION("existing files are kept and numbering continues after them") {
+    {
+      std::ofstream(base + ".0") << "earlier run\n";
+      std::ofstream(base + ".2") << "earlier run\n";
+    }
+    {
+      insp::mmap_sink sink(base, {.file_size = 128, .chunk_size = 32});
+      REQUIRE(sink.file_path(0) == base + ".1");
+      insp::mmap_writer writer(sink);
+      for (int i = 0; i < 20; ++i) {
+        writer << insp::make_inspectable(std::vector<int>{i, i}) << '\n';
+        writer.commit();
+      }
+      REQUIRE(sink.file_count() > 1);
+      REQUIRE(sink.file_path(1) == base + ".3");
+    }
+    REQUIRE(read_file(base + ".0") == "earlier run\n");
+    REQUIRE(read_file(base + ".2") == "earlier run\n");
+  }
+
+  SECTION("sinks sharing a path create distinct files") {
+    insp::mmap_sink first(base, {.file_size = 4096, .chunk_size = 256});
+    insp::mmap_sink second(base, {.file_size = 4096, .chunk_size = 256});
+    REQUIRE(first.file_path(0) == base + ".0");
+    REQUIRE(second.file_path(0) == base + ".1");
+    {
+      insp::mmap_writer a(first);
+      insp::mmap_writer b(second);
+      a << "first\n";
+      b << "second\n";
+    }
+    REQUIRE(read_file(first.file_path(0)).starts_with("first\n"));
+    REQUIRE(read_file(second.file_path(0)).starts_with("second\n"));
+  }
+
+  SECTION("concurrent writers reserve disjoint regions") {
+    constexpr int threads = 4;
+    constexpr int records = 500;
+    std::size_t files = 0;
+    {
+      insp::mmap_sink sink(base, {.file_size = 8192, .chunk_size = 256});
+      std::vector<std::thread> workers;
+      for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&sink, t] {
+          insp::mmap_writer writer(sink);
+          for (int i = 0; i < records; ++i) {
+            writer << insp::make_inspectable(std::vector<int>{t, i}) << '\n';
+            writer.commit();
+          }
+        });
+      }
+      for (auto& w : workers) {
+        w.join();
+      }
+      files = sink.file_count();
+    }
+    REQUIRE(files > 1);
+
+    std::vector<std::string> lines;
+    for (std::size_t f = 0; f < files; ++f) {
+      auto content = read_file(base + "." + std::to_string(f));
+      content.erase(std::remove(content.begin(), content.end(), '\0'),
+                    content.end());
+      std::istringstream iss(content);
+      for (std::string line; std::getline(iss, line);) {
+        lines.push_back(line);
+      }
+    }
+    std::vector<std::string> expected;
+    for (int t = 0; t < threads; ++t) {
+      for (int i = 0; i < records; ++i) {
+        expected.push_back(insp::to_string(std::vector<int>{t, i}));
+      }
+    }
+    std::sort(lines.begin(), lines.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(lines == expected);
+  }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/any.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/iterative.hpp>
+#include <inspector/optional.hpp>  // IWYU pragma: keep
+#include <inspector/style.hpp>
+#include <inspector/type_name.hpp>
+#include <inspector/utility.hpp>  // IWYU pragma: keep
+
+namespace {
+
+struct arrow_style {
+  static constexpr std::string_view separator = " | ";
+  static constexpr std::string_view key_separator = " -> ";
+  static constexpr std::size_t indent_width = 0;
+};
+
+struct bulleted_style {
+  static constexpr std::string_view separator = " ;  ";
+  static constexpr std::string_view key_separator = " = ";
+  static constexpr std::size_t indent_width = 4;
+};
+
+struct spaced_style {
+  static constexpr std::string_view separator = " ";
+  static constexpr std::string_view key_separator = " ";
+  static constexpr std::size_t indent_width = 1;
+};
+
+// Forwards the style to its members.
+struct record {
+  std::vector<int> values;
+
+  template <typename Style = insp::default_style>
+  auto inspect(std::ostream& os) const -> std::ostream& {
+    return os << "record" << insp::make_inspectable<Style>(values);
+  }
+};
+
+struct throwing {
+  auto inspect(std::ostream& /*unused*/) const -> std::ostream& {
+    throw std::runtime_error("throwing");
+  }
+};
+
+using payload = std::map<std::string, std::vector<std::pair<int, char>>>;
+
+auto make_payload() -> payload {
+  return {{"a", {{1, 'x'}, {2, 'y'}}}, {"b", {}}};
+}
+
+}  // namespace
+
+TEST_CASE("Inspect with the default style", "[style]") {
+  const auto p = make_payload();
+  REQUIRE(insp::to_string<insp::default_style>(p) == insp::to_string(p));
+  REQUIRE(insp::to_string(p) == "{a: [(1, x), (2, y)], b: []}");
+
+  std::ostringstream os;
+  insp::inspector<std::vector<int>>::inspect(os, {1, 2});
+  REQUIRE(os.str() == "[1, 2]");
+}
+
+TEST_CASE("Inspect with the compact style", "[style]") {
+  SECTION("containers, pairs and tuples") {
+    REQUIRE(insp::to_string<insp::compact_style>(make_payload()) ==
+            "{a:[(1,x),(2,y)],b:[]}");
+    REQUIRE(insp::to_string<insp::compact_style>(
+                std::make_tuple(1, std::optional<std::vector<int>>{{2, 3}},
+                                std::optional<int>{})) ==
+            "(1,[2,3],nullopt)");
+
+    std::queue<int> q;
+    q.push(1);
+    q.push(2);
+    REQUIRE(insp::to_string<insp::compact_style>(q) == "[1,2]");
+  }
+
+  SECTION("wrappers forward the style") {
+    const std::vector<int> v{1, 2};
+    REQUIRE(insp::to_string<insp::compact_style>(insp::annotated(v)) ==
+            "std::vector<int>[1,2]");
+    REQUIRE(insp::to_string<insp::compact_style>(insp::any_inspectable(v)) ==
+            "[1,2]");
+    REQUIRE(insp::to_string<insp::compact_style>(insp::iterative(
+                make_payload())) == "{a:[(1,x),(2,y)],b:[]}");
+    REQUIRE(insp::to_string<insp::compact_style>(record{{3, 4}}) ==
+            "record[3,4]");
+    REQUIRE(insp::to_string(record{{3, 4}}) == "record[3, 4]");
+  }
+}
+
+TEST_CASE("Inspect with the pretty style", "[style]") {
+  const std::string expected =
+      "{\n"
+      "  a: [\n"
+      "    (1, x),\n"
+      "    (2, y)\n"
+      "  ],\n"
+      "  b: []\n"
+      "}";
+
+  SECTION("nested containers") {
+    REQUIRE(insp::to_string<insp::pretty_style>(make_payload()) == expected);
+    REQUIRE(insp::to_string<insp::pretty_style>(std::vector<int>{}) == "[]");
+  }
+
+  SECTION("iterative engine") {
+    REQUIRE(insp::to_string<insp::pretty_style>(
+                insp::iterative(make_payload())) == expected);
+  }
+
+  SECTION("indentation is restored on the stream") {
+    std::ostringstream os;
+    const std::vector<int> one{1};
+    const std::vector<int> two{2};
+    os << insp::make_inspectable<insp::pretty_style>(one) << ' '
+       << insp::make_inspectable<insp::pretty_style>(two);
+    REQUIRE(os.str() == "[\n  1\n] [\n  2\n]");
+  }
+
+  SECTION("indentation is restored when an inspector throws") {
+    const std::vector<std::map<int, std::vector<throwing>>> bad{
+        {{1, {throwing{}}}}};
+    std::ostringstream os;
+    REQUIRE_THROWS_AS(os << insp::make_inspectable<insp::pretty_style>(bad),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(
+        os << insp::make_inspectable<insp::pretty_style>(insp::iterative(bad)),
+        std::runtime_error);
+
+    os.str("");
+    os << insp::make_inspectable<insp::pretty_style>(std::vector<int>{1});
+    REQUIRE(os.str() == "[\n  1\n]");
+  }
+}
+
+TEST_CASE("Inspect with a user-defined style", "[style]") {
+  STATIC_REQUIRE(insp::is_style_v<arrow_style>);
+  STATIC_REQUIRE(insp::is_style_v<insp::pretty_style>);
+  STATIC_REQUIRE_FALSE(insp::is_style_v<int>);
+  STATIC_REQUIRE_FALSE(insp::is_style_v<std::vector<int>>);
+
+  // any_inspectable erases the built-in styles only and rejects the others
+  // with a static_assert instead of falling back to the default style.
+  STATIC_REQUIRE(insp::detail::is_erased_style_v<insp::pretty_style>);
+  STATIC_REQUIRE_FALSE(insp::detail::is_erased_style_v<arrow_style>);
+  REQUIRE(insp::to_string<insp::pretty_style>(insp::any_inspectable(
+              std::vector<int>{1})) == "[\n  1\n]");
+
+  REQUIRE(insp::to_string<arrow_style>(make_payload()) ==
+          "{a -> [(1 | x) | (2 | y)] | b -> []}");
+
+  SECTION("indented styles end lines with the trimmed separator") {
+    const std::string expected =
+        "{\n"
+        "    a = [\n"
+        "        (1 ;  x) ;\n"
+        "        (2 ;  y)\n"
+        "    ] ;\n"
+        "    b = []\n"
+        "}";
+    REQUIRE(insp::to_string<bulleted_style>(make_payload()) == expected);
+    REQUIRE(insp::to_string<bulleted_style>(insp::iterative(
+                make_payload())) == expected);
+    REQUIRE(insp::to_string<spaced_style>(std::vector<int>{1, 2}) ==
+            "[\n 1\n 2\n]");
+  }
+}
@@ -0,0 +1,127 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <inspector/chrono.hpp>
+#include <inspector/containers.hpp>  // IWYU pragma: keep
+#include <inspector/core.hpp>
+#include <inspector/optional.hpp>  // IWYU pragma: keep
+#include <inspector/type_name.hpp>
+#include <inspector/utility.hpp>  // IWYU pragma: keep
+
+namespace type_name_ns {
+
+struct record {
+  int id = 7;
+};
+
+auto inspect(std::ostream& os, const record& obj) -> std::ostream& {
+  return os << "id=" << obj.id;
+}
+
+}  // namespace type_name_ns
+
+namespace {
+
+struct stripped_name {
+  std::array<char, 128> buffer{};
+  std::size_t size = 0;
+
+  constexpr auto view() const -> std::string_view {
+    return {buffer.data(), size};
+  }
+};
+
+constexpr auto strip(std::string_view name) -> stripped_name {
+  stripped_name out;
+  out.size = insp::detail::strip_type_keywords(name, out.buffer.data());
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("Compile-time type names", "[type_name]") {
+  SECTION("fundamental and user types") {
+    STATIC_REQUIRE(insp::type_name<int>() == "int");
+    STATIC_REQUIRE(insp::type_name<const double>() == "double");
+    STATIC_REQUIRE(insp::type_name<type_name_ns::record>() ==
+                   "type_name_ns::record");
+    STATIC_REQUIRE(insp::type_name<std::byte>() == "std::byte");
+  }
+
+  SECTION("types of the library's detail namespace stay qualified") {
+    STATIC_REQUIRE(insp::type_name<insp::detail::string_leaf_sink>() ==
+                   "insp::detail::string_leaf_sink");
+    using namespace std::chrono_literals;
+    REQUIRE(insp::to_string(insp::annotated(insp::humanized(5ms)))
+                .starts_with("insp::detail::humanized_duration<"));
+  }
+
+  SECTION("MSVC type keywords are stripped") {
+    STATIC_REQUIRE(strip("struct type_name_ns::record").view() ==
+                   "type_name_ns::record");
+    STATIC_REQUIRE(strip("enum std::byte").view() == "std::byte");
+    STATIC_REQUIRE(
+        strip("class std::vector<struct a::b,class std::allocator<struct "
+              "a::b> >")
+            .view() == "std::vector<a::b,std::allocator<a::b> >");
+    STATIC_REQUIRE(strip("union u").view() == "u");
+    STATIC_REQUIRE(strip("ns::subclass ").view() == "ns::subclass ");
+  }
+
+  SECTION("standard library types") {
+    STATIC_REQUIRE(insp::type_name<std::string>() == "std::string");
+    STATIC_REQUIRE(insp::type_name<std::vector<int>>() == "std::vector<int>");
+    STATIC_REQUIRE(insp::type_name<std::array<char, 16>>() ==
+                   "std::array<char, 16>");
+    STATIC_REQUIRE(insp::type_name<std::map<int, std::string>>() ==
+                   "std::map<int, std::string>");
+    STATIC_REQUIRE(insp::type_name<std::optional<std::vector<int>>>() ==
+                   "std::optional<std::vector<int>>");
+    STATIC_REQUIRE(insp::type_name<std::pair<int, char>>() ==
+                   "std::pair<int, char>");
+  }
+
+  SECTION("tuples") {
+    STATIC_REQUIRE(insp::type_name<std::tuple<>>() == "std::tuple<>");
+    STATIC_REQUIRE(insp::type_name<std::tuple<int>>() == "std::tuple<int>");
+    STATIC_REQUIRE(insp::type_name<std::tuple<int, std::string, char>>() ==
+                   "std::tuple<int, std::string, char>");
+  }
+
+  SECTION("names are cached per type") {
+    REQUIRE(insp::type_name<std::vector<int>>().data() ==
+            insp::type_name<std::vector<int>>().data());
+  }
+}
+
+TEST_CASE("Annotated inspection", "[type_name]") {
+  SECTION("bracketed values are prefixed") {
+    const std::map<int, std::string> m{{1, "a"}};
+    REQUIRE(insp::to_string(insp::annotated(m)) ==
+            "std::map<int, std::string>{1: a}");
+    REQUIRE(insp::to_string(insp::annotated(std::vector<int>{1, 2})) ==
+            "std::vector<int>[1, 2]");
+    REQUIRE(insp::to_string(insp::annotated(std::make_tuple(1, 'x'))) ==
+            "std::tuple<int, char>(1, x)");
+  }
+
+  SECTION("other values are wrapped in braces") {
+    REQUIRE(insp::to_string(insp::annotated(42)) == "int{42}");
+    REQUIRE(insp::to_string(insp::annotated(std::string("hi"))) ==
+            "std::string{hi}");
+    REQUIRE(insp::to_string(insp::annotated(std::optional<int>{})) ==
+            "std::optional<int>{nullopt}");
+    REQUIRE(insp::to_string(insp::annotated(type_name_ns::record{})) ==
+            "type_name_ns::record{id=7}");
+  }
+}